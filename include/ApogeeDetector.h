@@ -0,0 +1,49 @@
+#ifndef APOGEEDETECTOR_H
+#define APOGEEDETECTOR_H
+
+#include <stdint.h>
+
+// Apogee detection by vote over the altitude sample history.
+//
+// Each NEW altitude sample (baro read or SIMP) casts one vote for "past apogee"
+// when both indicators agree:
+//   - filtered vertical velocity <= 0 (a second low-pass over getVerticalVelocity(),
+//     APOGEE_VEL_ALPHA; "<=" so a stuck zero-derivative velocity cannot block it)
+//   - altitude is below the running maximum by more than
+//     max(APOGEE_MIN_DROP_M, APOGEE_DROP_SIGMA * sigma), where sigma is the
+//     altitude noise measured on the launch pad
+// Apogee is declared when at least APOGEE_VOTE_N of the last APOGEE_VOTE_M samples
+// voted. Detection latency is measured from the sample that set the maximum.
+//
+// Latency scales with the sample rate, because both the velocity filter and the
+// vote count samples, not time. With the defaults it is about 0.6 s at the 50 Hz
+// baro. In simulation mode one sample arrives per SIMP (1 Hz), and APOGEE comes
+// about 9 s after the peak: the filter lags by several samples, and 5 votes take
+// at least 4 s more (test/test_apogee_detector).
+
+struct ApogeeDetectorStatus {
+    uint32_t samples;       // Samples voted on since reset
+    float maxAltitude;      // m
+    uint32_t peakMs;        // Sample time of maxAltitude
+    float filtVelocity;     // m/s
+    float noiseM;           // Pad altitude noise sigma (0 until measured)
+    float thresholdM;       // Current drop threshold
+    uint8_t votes;          // Votes in the current window
+    bool detected;
+    uint32_t detectMs;      // Sample time apogee was declared
+    uint32_t latencyMs;     // detectMs - peakMs
+};
+
+// Forget the flight (LAUNCH_PAD entry); keeps nothing from earlier samples.
+void resetApogeeDetector();
+
+// On the pad: learn altitude noise from successive samples.
+void apogeeObservePad(float altitude, uint32_t sampleMs);
+
+// In ascent: feed the latest sample. Samples with the same sampleMs as the previous
+// call are ignored. Returns true once apogee has been declared (latched).
+bool apogeeDetectorUpdate(float altitude, float verticalVel, uint32_t sampleMs);
+
+void getApogeeDetectorStatus(ApogeeDetectorStatus* out);
+
+#endif // APOGEEDETECTOR_H
@@ -0,0 +1,143 @@
+#ifndef BINARYFRAME_H
+#define BINARYFRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Compact binary telemetry frames (side stream next to the mandated CSV line).
+// This header and src/telemetry/BinaryFrame.cpp have no Arduino dependencies and
+// are the reference encoder AND decoder: the GCS can compile them unchanged.
+//
+// Wire format of one frame:
+//     0x00 | COBS( type | version | body... | crc16_lo | crc16_hi ) | 0x00
+// COBS removes every 0x00 from the payload, so 0x00 only ever delimits frames and
+// never appears in ASCII telemetry lines: a receiver splits the byte stream on
+// 0x00 and on "\r\n". CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) covers
+// type..body. All multi-byte fields are little-endian.
+
+static const uint8_t BIN_FRAME_VERSION = 1;
+
+enum BinFrameType {
+    BIN_FRAME_SAMPLE = 0x01,  // Full sensor sample (BinSample); also the delta keyframe
+    BIN_FRAME_DELTA  = 0x02,  // Sample as zigzag-varint deltas from the previous frame
+    BIN_FRAME_STATE  = 0x03,  // Flight-state transition event (BinStateEvent)
+    BIN_FRAME_BURST  = 0x04,  // Chunk of burst history around a transition
+    BIN_FRAME_LOG    = 0x05,  // Chunk of a stored log file (LOG,GET downlink)
+    BIN_FRAME_EVENT  = 0x06   // Event journal record (flight log / black box only)
+};
+
+// Largest raw (pre-COBS) frame: type + version + body + CRC.
+static const size_t BIN_MAX_BODY = 240;
+static const size_t BIN_MAX_RAW = 2 + BIN_MAX_BODY + 2;
+// COBS adds one byte per 254 plus the two delimiters.
+static const size_t BIN_MAX_WIRE = BIN_MAX_RAW + BIN_MAX_RAW / 254 + 1 + 2;
+
+// One sensor sample as packed scaled integers (body of BIN_FRAME_SAMPLE).
+struct BinSample {
+    uint16_t seq;          // Increments per binary frame sent (wraps)
+    uint32_t captureMs;    // SensorSnapshot::captureMs
+    uint8_t state;         // FlightState enum value
+    uint8_t gpsSats;
+    int32_t altitudeDm;    // 0.1 m
+    uint16_t pressureDaPa; // 0.01 kPa
+    int16_t temperatureDc; // 0.1 °C
+    uint16_t voltageMv;    // mV
+    int16_t currentMa;     // mA
+    int16_t gyroDds[3];    // 0.1 deg/s, R/P/Y
+    int16_t accelCms2[3];  // 0.01 m/s², R/P/Y
+    int32_t gpsLatE7;      // 1e-7 deg
+    int32_t gpsLonE7;      // 1e-7 deg
+    int32_t gpsAltDm;      // 0.1 m
+    int16_t vertVelCms;    // 0.01 m/s
+};
+
+static const size_t BIN_SAMPLE_BODY_SIZE = 46;
+
+// CRC-16/CCITT-FALSE.
+uint16_t crc16Ccitt(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF);
+
+// COBS encode/decode. Return output length, 0 if it does not fit / is malformed.
+size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out, size_t outCap);
+size_t cobsDecode(const uint8_t* in, size_t len, uint8_t* out, size_t outCap);
+
+// Build a complete wire frame (delimiters included). Returns wire length, 0 on error.
+size_t binEncodeFrame(uint8_t type, const uint8_t* body, size_t bodyLen,
+                      uint8_t* out, size_t outCap);
+
+// Decode the bytes BETWEEN two 0x00 delimiters. Verifies CRC and version.
+// On success returns body length and sets *type; body is copied to bodyOut.
+// Returns 0 on any error (bad COBS, CRC mismatch, unknown version).
+size_t binDecodeFrame(const uint8_t* cobsBytes, size_t len, uint8_t* type,
+                      uint8_t* bodyOut, size_t bodyCap);
+
+// BIN_FRAME_SAMPLE body <-> BinSample. pack returns BIN_SAMPLE_BODY_SIZE.
+size_t binPackSample(const BinSample& s, uint8_t* body);
+bool binUnpackSample(const uint8_t* body, size_t len, BinSample* out);
+
+// BIN_FRAME_DELTA body: seq (u16), then one zigzag LEB128 varint per field of
+// (current - previous), in BinSample declaration order (capture_ms, state,
+// gps_sats, altitude, ... vert_vel; the three-axis fields count three each, so
+// 18 values). Typical size 20-30 bytes vs 46.
+// A delta only applies to the frame with seq - 1; see BinStreamDecoder.
+static const size_t BIN_DELTA_FIELD_COUNT = 18;
+static const size_t BIN_DELTA_MAX_BODY = 2 + BIN_DELTA_FIELD_COUNT * 5;
+
+size_t binPackDelta(const BinSample& prev, const BinSample& cur, uint8_t* body, size_t cap);
+bool binUnpackDelta(const BinSample& prev, const uint8_t* body, size_t len, BinSample* out);
+
+// Reference stream decoder for SAMPLE + DELTA frames. A lost frame breaks the
+// delta chain; the decoder then ignores deltas until the next keyframe, so a
+// loss never produces wrong values, only missing ones.
+struct BinStreamDecoder {
+    BinSample last;
+    bool valid;  // last is a correctly decoded sample
+};
+
+void binDecoderReset(BinStreamDecoder* dec);
+// Feed one decoded frame (type + body from binDecodeFrame). Returns true and fills
+// *out when the frame yields a sample.
+bool binDecoderFeed(BinStreamDecoder* dec, uint8_t type, const uint8_t* body, size_t len,
+                    BinSample* out);
+
+// BIN_FRAME_STATE body (11 bytes): burst_id u8, from u8, to u8, transition_ms u32,
+// mission_ms u32 (0xFFFFFFFF if mission time not set).
+struct BinStateEvent {
+    uint8_t burstId;
+    uint8_t fromState;
+    uint8_t toState;
+    uint32_t transitionMs;  // FSW millis() at setFlightState()
+    uint32_t missionMs;
+};
+static const size_t BIN_STATE_BODY_SIZE = 11;
+size_t binPackStateEvent(const BinStateEvent& e, uint8_t* body);
+bool binUnpackStateEvent(const uint8_t* body, size_t len, BinStateEvent* out);
+
+// BIN_FRAME_BURST body: burst_id u8, first_index i8 (negative = before the
+// transition), count u8, then count BIN_FRAME_SAMPLE bodies (46 bytes each).
+// Sample k of the chunk is history index first_index + k; its seq field holds
+// the same index (two's complement).
+static const size_t BIN_BURST_HEADER_SIZE = 3;
+static const uint8_t BIN_BURST_MAX_SAMPLES = (BIN_MAX_BODY - BIN_BURST_HEADER_SIZE) / BIN_SAMPLE_BODY_SIZE;
+
+// BIN_FRAME_LOG body: xfer_id u8, offset u32 (file byte offset of data[0]), then
+// the file bytes themselves (length = body length - header).
+static const size_t BIN_LOG_HEADER_SIZE = 5;
+static const size_t BIN_LOG_MAX_DATA = BIN_MAX_BODY - BIN_LOG_HEADER_SIZE;
+
+// BIN_FRAME_EVENT body (20 bytes): index u32 (journal position), boot u16, id u8,
+// a u8, time_us u64 (monotonic µs of that boot), b u32. IDs and payload meaning are
+// listed in EventJournal.h.
+static const size_t BIN_EVENT_BODY_SIZE = 20;
+
+// Zigzag LEB128 varint helpers. put returns bytes written (<= 5), get returns bytes
+// consumed (0 on truncated input).
+size_t binPutVarint(uint8_t* p, int32_t v);
+size_t binGetVarint(const uint8_t* p, size_t len, int32_t* v);
+
+// Little-endian helpers shared by the frame types.
+void binPutU16(uint8_t* p, uint16_t v);
+void binPutU32(uint8_t* p, uint32_t v);
+uint16_t binGetU16(const uint8_t* p);
+uint32_t binGetU32(const uint8_t* p);
+
+#endif // BINARYFRAME_H
@@ -0,0 +1,49 @@
+#ifndef BINARYTELEMETRY_H
+#define BINARYTELEMETRY_H
+
+#include <stdint.h>
+#include "BinaryFrame.h"
+
+struct SensorSnapshot;
+
+// High-rate binary telemetry side stream (BIN command).
+// When enabled, updateBinaryTelemetry() sends one BIN_FRAME_SAMPLE per period on
+// LINK_STREAM, i.e. only in airtime left over after the mandated CSV packet;
+// frames that do not fit the budget are dropped (the sequence number shows gaps).
+// In delta mode most frames are BIN_FRAME_DELTA against the previous frame, with a
+// full BIN_FRAME_SAMPLE keyframe every BIN_KEYFRAME_INTERVAL frames and right
+// after any frame the scheduler dropped (the ground cannot have its predecessor).
+
+// Allowed stream rate range (Hz). ~52 bytes/frame: 10 Hz is ~520 B/s of the
+// ~860 B/s link, so the upper end is only reached when nothing else is queued.
+static const uint8_t BIN_RATE_MIN_HZ = 1;
+static const uint8_t BIN_RATE_MAX_HZ = 20;
+static const uint8_t BIN_RATE_DEFAULT_HZ = 10;
+static const uint8_t BIN_KEYFRAME_INTERVAL = 10;
+
+// Encoder statistics since the stream was last enabled (bytes/sample and cost).
+struct BinTelemetryStats {
+    uint32_t framesSent;
+    uint32_t framesDropped;   // Refused by the link scheduler
+    uint32_t keyframes;
+    uint32_t wireBytes;       // Sent bytes incl. COBS + delimiters; / framesSent = bytes/sample
+    uint32_t lastEncodeCycles;
+    uint32_t maxEncodeCycles; // CPU cycles for snapshot scaling + pack + COBS/CRC
+};
+
+void initBinaryTelemetry();
+
+// Enable at rateHz (clamped to the range above) or disable the stream.
+// delta selects delta/varint frames with periodic keyframes.
+void setBinaryTelemetry(bool enabled, uint8_t rateHz, bool delta = false);
+bool isBinaryTelemetryEnabled();
+
+// Scale a snapshot into a packed sample (sequence number not set).
+void binSampleFromSnapshot(const SensorSnapshot& snap, uint8_t state, BinSample* out);
+
+void getBinaryTelemetryStats(BinTelemetryStats* out);
+
+// Call every main-loop tick.
+void updateBinaryTelemetry(uint32_t now_ms);
+
+#endif // BINARYTELEMETRY_H
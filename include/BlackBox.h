@@ -0,0 +1,71 @@
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "FlightLog.h"  // LogListFn
+
+// Fallback black box for when the SD card is lost: the last few minutes of 50 Hz
+// state, in a LittleFS partition in the Teensy 4.1 program flash (or the optional
+// QSPI flash chip when built with -DBLACKBOX_QSPI). Same binary frames as the SD
+// log (FlightLog.h), stored as a ring of segment files /BBnnnnnn.BIN.
+//
+// Flash rules:
+// - Erase-ahead only runs on the ground: in PRELAUNCH/LAUNCH_PAD (and after the
+//   recording stops) free blocks are pre-erased one at a time, so most blocks
+//   LittleFS allocates in flight are already blank.
+// - In-flight erases are reduced, not ruled out: syncs and segment rolls can make
+//   LittleFS compact a metadata block, and blocks freed in flight are not
+//   pre-erased (details in BlackBox.cpp). BlackBoxStats records the worst call
+//   times and counts calls over BLACKBOX_SLOW_OP_US.
+// - The oldest segment is deleted to make room only on the ground; in flight the
+//   ring is allowed to grow into the pre-erased free space.
+// - LittleFS is copy-on-write, so a power loss can only lose data written since
+//   the last sync (at most BLACKBOX_SYNC_MS); closed segments are never touched.
+
+static const uint32_t BLACKBOX_FS_BYTES = 2UL * 1024 * 1024;   // Program-flash partition
+static const uint32_t BLACKBOX_PERIOD_MS = 20;                 // 50 Hz
+static const uint32_t BLACKBOX_PAGE_BYTES = 256;               // One flash page per write
+static const uint32_t BLACKBOX_SEGMENT_BYTES = 64UL * 1024;    // ~25 s per segment
+static const uint8_t BLACKBOX_MAX_SEGMENTS = 12;               // ~5 min retained on the ground
+static const uint32_t BLACKBOX_SYNC_MS = 1000;
+static const uint32_t BLACKBOX_ERASE_PERIOD_MS = 100;          // Erase-ahead pacing
+static const uint32_t BLACKBOX_LANDED_STOP_MS = 120000;        // Freeze the ring after landing
+static const uint32_t BLACKBOX_SLOW_OP_US = 5000;              // Longer than any write: erase or compaction
+
+struct BlackBoxStats {
+    uint32_t framesLogged;
+    uint32_t framesDropped;
+    uint32_t pagesWritten;
+    uint32_t segmentsOpened;
+    uint32_t segmentsDeleted;
+    uint32_t eraseAheadCalls;
+    uint32_t maxPageWriteUs;
+    uint32_t maxSyncUs;
+    uint32_t maxEraseUs;
+    uint32_t maxRollUs;       // Segment close + open (directory commits)
+    uint32_t slowOps;         // Page writes, syncs and rolls over BLACKBOX_SLOW_OP_US
+    uint32_t oldestSegment;
+    uint32_t newestSegment;
+    uint8_t segmentCount;
+};
+
+void initBlackBox();
+bool isBlackBoxActive();
+
+// Call every main-loop tick (records at 50 Hz; one LittleFS call per tick at most).
+void updateBlackBox(uint32_t now_ms);
+
+// Append one binary frame (BIN_FRAME_* type + body).
+bool blackBoxFrame(uint8_t type, const uint8_t* body, size_t len);
+
+void getBlackBoxStats(BlackBoxStats* out);
+
+// Segment access for the radio downlink; names as listed ("BBnnnnnn.BIN").
+// The segment currently being written cannot be opened.
+void blackBoxList(LogListFn fn, void* ctx);
+bool blackBoxOpenRead(const char* name, uint32_t* size);
+int32_t blackBoxReadAt(uint32_t offset, uint8_t* buf, size_t len);  // -1 on error
+void blackBoxCloseRead();
+
+#endif // BLACKBOX_H
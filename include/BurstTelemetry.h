@@ -0,0 +1,38 @@
+#ifndef BURSTTELEMETRY_H
+#define BURSTTELEMETRY_H
+
+#include <stdint.h>
+#include "FlightState.h"
+
+// Event-triggered burst telemetry around flight-state transitions.
+// A 20 Hz history of packed samples is kept continuously. On every transition
+// a BIN_FRAME_STATE event goes out immediately (LINK_ACK priority), then the
+// BURST_PRE_SAMPLES before and BURST_POST_SAMPLES after the transition are sent
+// as BIN_FRAME_BURST chunks on LINK_BURST, i.e. only in spare airtime.
+
+static const uint32_t BURST_SAMPLE_PERIOD_MS = 50;  // 20 Hz history
+static const uint8_t BURST_PRE_SAMPLES = 20;        // 1 s before the transition
+static const uint8_t BURST_POST_SAMPLES = 20;       // 1 s after
+
+struct BurstStats {
+    uint32_t transitions;     // Transitions seen
+    uint32_t eventsDropped;   // BIN_FRAME_STATE frames refused by the link
+    uint32_t burstsSkipped;   // Transitions whose history could not be queued
+    uint32_t samplesSent;
+};
+
+void initBurstTelemetry();
+
+// Enable/disable bursts (on by default). Event frames are sent either way.
+void setBurstTelemetryEnabled(bool enabled);
+bool isBurstTelemetryEnabled();
+
+// Called by setFlightState() when the state actually changes.
+void onFlightStateTransition(FlightState from, FlightState to);
+
+// Call every main-loop tick: records history and sends pending burst chunks.
+void updateBurstTelemetry(uint32_t now_ms);
+
+void getBurstStats(BurstStats* out);
+
+#endif // BURSTTELEMETRY_H
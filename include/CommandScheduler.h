@@ -0,0 +1,52 @@
+#ifndef COMMAND_SCHEDULER_H
+#define COMMAND_SCHEDULER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Time-tagged commands: CMD,<TEAM_ID>,AT,<hh:mm:ss[.mmm]>,<COMMAND>[,<PARAMS>...]
+// queues the inner command to run when mission time reaches the given time of day.
+// Entries sit in a fixed-size min-heap keyed on their due time, so each tick only
+// looks at the root. The due time is converted to a deadline on the 64-bit
+// monotonic clock (getMonotonicUs) when the command is queued; a later ST does not
+// move commands already queued.
+//
+// When a command runs, "[AT] RUN <id> <late_us> OK|REJ <command>" reports how far
+// after its scheduled time it executed and whether the command itself was accepted.
+
+static const uint8_t AT_MAX_PENDING = 8;
+static const size_t AT_MAX_LINE = 80;                 // Stored inner command incl. "CMD,<id>,"
+static const uint32_t AT_MAX_AHEAD_MS = 12UL * 3600 * 1000;  // Later than this = time already passed
+
+struct ScheduledCommand {
+    uint64_t dueUs;         // Monotonic deadline
+    uint32_t missionMs;     // Requested mission time of day (for listing)
+    uint16_t id;
+    char line[AT_MAX_LINE];
+};
+
+struct CommandSchedulerStats {
+    uint32_t executed;
+    uint32_t lastLateUs;
+    uint32_t maxLateUs;
+};
+
+void initCommandScheduler();
+
+// Queue line (a complete "CMD,..." string) to run at missionMs (time of day).
+// Fails if mission time is not set, the time has already passed, the line is too
+// long or the queue is full. On success *id identifies the entry.
+bool scheduleCommand(uint32_t missionMs, const char* line, uint16_t* id);
+
+// Remove a pending entry; false if no entry has that id.
+bool cancelScheduledCommand(uint16_t id);
+
+// Copy up to max pending entries into out, next to run first; returns the count.
+uint8_t listScheduledCommands(ScheduledCommand* out, uint8_t max);
+
+void getCommandSchedulerStats(CommandSchedulerStats* out);
+
+// Run every entry whose deadline has passed (call every main-loop tick).
+void updateCommandScheduler();
+
+#endif // COMMAND_SCHEDULER_H
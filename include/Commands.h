@@ -1,8 +1,20 @@
 #ifndef COMMANDS_H
 #define COMMANDS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+// Longest command line accepted, including the terminator.
+static const size_t COMMAND_MAX_LINE = 256;
+// Most parameters any command takes after its token.
+static const uint8_t COMMAND_MAX_ARGS = 6;
+
+// Parameters of one command, pointing into the tokenized line (no copies).
+struct CommandArgs {
+    const char* arg[COMMAND_MAX_ARGS];
+    uint8_t count;
+};
+
 // Initialize command system
 void initCommands();
 
@@ -29,11 +41,89 @@ bool processCALCommand();
 // MEC - Mechanism: CMD,<TEAM_ID>,MEC,<DEVICE>,<ON_OFF>
 bool processMECCommand(const char* device, const char* onOff);
 
+// AGG - Aggregate telemetry mode: CMD,<TEAM_ID>,AGG,ON|OFF
+bool processAGGCommand(const char* onOff);
+
+// BIN - Binary telemetry side stream: CMD,<TEAM_ID>,BIN,ON|DELTA[,<rate_hz>]|OFF|STATS
+// rate may be nullptr (default rate). STATS replies with the encoder and
+// transition-burst statistics.
+bool processBINCommand(const char* mode, const char* rate);
+
+// LOG - SD flight log / black box: CMD,<TEAM_ID>,LOG,STAT|BBSTAT|CLOSE|BENCH[,<sectors>]
+// and log downlink: LOG,LIST[,<first>] | LOG,GET,<name>,<offset>[,<length>] | LOG,ACK,<offset> | LOG,STOP
+bool processLOGCommand(const CommandArgs& args);
+
+// PRM - Parameters: CMD,<TEAM_ID>,PRM,GET,<name|id> | SET,<name|id>,<value> | LIST[,<first>] | RESET
+bool processPRMCommand(const CommandArgs& args);
+
+// AT - Time-tagged command: CMD,<TEAM_ID>,AT,<hh:mm:ss[.mmm]>,<COMMAND>[,<PARAMS>...]
+//      | AT,LIST | AT,CANCEL,<id>  (see CommandScheduler.h)
+bool processATCommand(const CommandArgs& args);
+
+// EVT - Event journal readout: CMD,<TEAM_ID>,EVT[,<first>]  (see EventJournal.h)
+bool processEVTCommand(const char* first);
+
+// FSM - Flight transition table stats: CMD,<TEAM_ID>,FSM[,<first>]  (see StateLogic.h)
+bool processFSMCommand(const char* first);
+
+// Outcome of one command line, reported in ACK replies (numeric code on the wire).
+enum CommandResult : uint8_t {
+    CMD_OK = 0,
+    CMD_ERR_FORMAT = 1,     // Not CMD,<TEAM_ID>,..., bad sequence field or too many fields
+    CMD_ERR_UNKNOWN = 2,    // Unknown command token
+    CMD_ERR_PARAMS = 3,     // Wrong parameter count or type
+    CMD_ERR_REJECTED = 4,   // Well-formed, but the handler refused it (e.g. SIMP outside simulation)
+    CMD_ERR_TEAM = 5        // Another team's command (never acknowledged)
+};
+
+// Acknowledgement: a command carrying a sequence field right after the team ID,
+//   CMD,<TEAM_ID>,#<seq>,<COMMAND>[,<PARAMS>...]     (seq 0-65535)
+// is answered at once on LINK_ACK with
+//   [ACK] <seq> OK 0 <us>   or   [ACK] <seq> NACK <code> <us>
+// where us is receive-to-reply time. A repeat of a recently acknowledged
+// (seq, line) is answered again without executing the command a second time, so
+// the ground can retry safely. Lines without a sequence field are never answered.
+static const uint8_t COMMAND_ACK_HISTORY = 8;
+
 // Parse and process command string
-// Format: CMD,<TEAM_ID>,<COMMAND>,<PARAMS>
+// Format: CMD,<TEAM_ID>,[#<SEQ>,]<COMMAND>,<PARAMS>
+// The command token is looked up in a compile-time perfect-hash table of command
+// descriptors; arity and parameter types are checked before the handler runs.
 bool parseCommand(const char* cmdString);
 
-// Process incoming commands
+// As parseCommand(), but tokenizes the caller's buffer in place (it is modified).
+bool parseCommandInPlace(char* line);
+
+// As parseCommandInPlace(), returning the result code and sending the ACK reply
+// when the line carries a sequence field. rxMicros: micros() when the line arrived.
+CommandResult executeCommandLine(char* line, uint32_t rxMicros);
+
+// Upper bound on commands executed per processCommands() call (the RX queue depth).
+static const uint8_t COMMAND_MAX_PER_TICK = 8;
+
+// Receive-to-execute latency: from the line terminator arriving at the UART to
+// the command's handler returning.
+struct CommandLatencyStats {
+    uint32_t commands;
+    uint32_t lastUs;
+    uint32_t maxUs;
+    uint64_t totalUs;  // / commands = mean
+    uint32_t acks;
+    uint32_t nacks;
+    uint32_t duplicates;  // Retries answered from the ACK history
+};
+void getCommandLatencyStats(CommandLatencyStats* out);
+
+// OPTIONAL_DATA telemetry adapters (see OptionalFields.h); empty until a command arrives.
+struct SensorSnapshot;
+bool optCmdLatency(const SensorSnapshot& snap, uint32_t* out);
+bool optCmdLatencyMax(const SensorSnapshot& snap, uint32_t* out);
+
+#define COMMANDS_OPTIONAL_FIELDS(FIXED, UINT)   \
+    UINT("CMD_LAT_US", optCmdLatency)           \
+    UINT("CMD_LAT_MAX_US", optCmdLatencyMax)
+
+// Process incoming commands (all queued lines, up to COMMAND_MAX_PER_TICK)
 void processCommands();
 
 // Update command system (call periodically)
@@ -0,0 +1,37 @@
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Allocation-free CSV line builder for telemetry.
+// Each csvPut* call appends one field (with a leading comma after the first field).
+// Fixed-point fields are formatted with integer arithmetic and are byte-identical
+// to printf("%.<decimals>f") for float inputs: round-half-to-even on the exact
+// binary value, "-0.0" for small negatives, "nan"/"inf" for non-finite values.
+struct CsvWriter {
+    char* buf;
+    size_t cap;
+    size_t len;
+    uint16_t fields;
+    bool overflow;  // Set if any write did not fit; the line is then unusable
+};
+
+void csvBegin(CsvWriter* w, char* buf, size_t cap);
+
+void csvPutStr(CsvWriter* w, const char* s);
+void csvPutChar(CsvWriter* w, char c);
+// Unsigned integer, zero-padded to at least minDigits (like "%0<minDigits>lu").
+void csvPutUInt(CsvWriter* w, uint32_t v, uint8_t minDigits = 1);
+// Fixed resolution value, e.g. decimals = 1 for 0.1 m, 2 for 0.01 A, 4 for 0.0001 deg.
+// decimals must be <= 6.
+void csvPutFixed(CsvWriter* w, float v, uint8_t decimals);
+// "hh:mm:ss"
+void csvPutTime(CsvWriter* w, uint8_t h, uint8_t m, uint8_t s);
+// Empty field (keeps column positions when a value is unavailable).
+void csvPutEmpty(CsvWriter* w);
+
+// Terminate the line with "\r\n" and NUL. Returns line length, or 0 on overflow.
+size_t csvEnd(CsvWriter* w);
+
+#endif // CSVWRITER_H
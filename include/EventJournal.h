@@ -0,0 +1,71 @@
+#ifndef EVENTJOURNAL_H
+#define EVENTJOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Flight event journal: a fixed ring of small binary records (event ID, 64-bit
+// microsecond timestamp, two payload fields) for the moments worth reconstructing
+// after a flight - state transitions, camera start/stop, commands, sensor init
+// failures, simulation mode and time changes.
+//
+// - journalEvent() is main-loop only: its timestamp comes from getMonotonicUs(),
+//   which extends micros() without locking. A record is published by writing its
+//   sequence number last, so a reader never copies a half-written slot and a reset
+//   mid-write leaves that slot unpublished.
+// - The ring lives in DMAMEM (not cleared at startup) and each record's cache
+//   line is flushed after it is written, so the journal survives a reset; entries
+//   carry the boot number they were written in.
+// - updateEventJournal() mirrors new records into the SD flight log and the black
+//   box as BIN_FRAME_EVENT frames; EVT[,<first>] reads them over the radio.
+
+static const uint16_t JOURNAL_CAPACITY = 256;  // Power of two
+
+enum EventId : uint8_t {
+    EVT_BOOT = 1,         // a: 1 = earlier records kept, b: SRC_SRSR reset reason (0 if unknown)
+    EVT_STATE = 2,        // a: from state, b: to state
+    EVT_CAMERA = 3,       // a: camera 1/2, b: 1 = start, 0 = stop
+    EVT_COMMAND = 4,      // a: CommandResult, b: first 4 chars of the command token
+    EVT_SENSOR_FAIL = 5,  // a: JournalSensor, b: 0
+    EVT_SIM_MODE = 6,     // a: 1 = on, 0 = off
+    EVT_TIME_SET = 7,     // a: 0 = ST, 1 = ST,GPS, 2 = restored from RTC; b: mission ms
+    EVT_APOGEE = 8,       // a: votes, b: detection latency ms (see ApogeeDetector.h)
+    EVT_IMPACT = 9,       // a: 0.1 s before the still stretch, b: peak acceleration, 0.01 m/s² (see LandingDetector.h)
+    EVT_LANDING = 10      // a: 1 = after a touchdown impact, b: still time ms at confirmation
+};
+
+enum JournalSensor : uint8_t {
+    JSENSOR_BMP390 = 1,
+    JSENSOR_INA219 = 2,
+    JSENSOR_BNO055 = 3
+};
+
+struct JournalEntry {
+    uint64_t timeUs;  // getMonotonicUs() in the boot that wrote it
+    uint32_t seq;     // Journal index + 1; 0 while the slot is being written
+    uint16_t boot;
+    uint8_t id;       // EventId
+    uint8_t a;
+    uint32_t b;
+};
+
+// Call first in setup(): keeps a journal that survived a reset (new boot number),
+// clears a corrupt or never-initialized one, then records EVT_BOOT.
+void initEventJournal();
+
+// Record an event (main loop only - not from an IntervalTimer or pin interrupt).
+void journalEvent(EventId id, uint8_t a = 0, uint32_t b = 0);
+
+// Index one past the newest record; records [head - JOURNAL_CAPACITY, head) are kept.
+uint32_t journalHead();
+uint16_t journalBoot();
+
+// Copy record index; false if it was overwritten or is still being written.
+bool journalRead(uint32_t index, JournalEntry* out);
+
+const char* eventIdToString(uint8_t id);
+
+// Mirror new records into the flight log and black box (main loop).
+void updateEventJournal();
+
+#endif // EVENTJOURNAL_H
@@ -0,0 +1,74 @@
+#ifndef FLIGHTLOG_H
+#define FLIGHTLOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// On-board flight data recorder on the Teensy 4.1 built-in SD card (SDIO).
+// Every 100 Hz snapshot is logged as a BIN_FRAME_SAMPLE, events (state
+// transitions etc.) as their own binary frames - the same COBS/CRC framing as the
+// radio side stream, so one decoder reads both (GCS_AGENT_INTEGRATION.md §2.6).
+//
+// Real-time rules: frames are only copied into a RAM ring of 512-byte sectors in
+// the loop; at most one full, sector-aligned write is issued per tick, and only
+// when the card reports not busy. The file is preallocated contiguously and its
+// size set once at boot, so in-flight writes never touch the FAT or directory.
+
+static const uint32_t LOG_SECTOR_SIZE = 512;
+static const uint32_t LOG_RING_SECTORS = 16;                  // 8 KB = ~1.5 s of logging
+static const uint64_t LOG_PREALLOC_BYTES = 64ULL * 1024 * 1024; // ~3.5 h at 100 Hz
+static const uint32_t LOG_LANDED_CLOSE_MS = 60000;            // Auto-close this long after LANDED
+
+struct FlightLogStats {
+    uint32_t framesLogged;
+    uint32_t framesDropped;    // Ring full (card stalled) or file full
+    uint32_t sectorsWritten;
+    uint32_t busySkips;        // Ticks a full sector waited because the card was busy
+    uint32_t maxRingSectors;   // Peak ring fill, in sectors
+    uint32_t lastWriteUs;
+    uint32_t maxWriteUs;       // Longest single sector write() call
+    uint64_t totalWriteUs;
+    uint32_t maxAppendCycles;  // Longest frame encode + copy into the ring
+    uint64_t bytesWritten;
+};
+
+struct FlightLogBenchResult {
+    uint32_t sectors;
+    uint32_t elapsedUs;
+    uint32_t kbPerSec;
+    uint32_t minWriteUs;
+    uint32_t maxWriteUs;
+    uint32_t avgWriteUs;
+    uint32_t busyWaitUs;       // Time spent waiting for the card between writes
+};
+
+// Mount the card and create the next FLTnn.BIN. Logging is disabled (and the
+// rest of the FSW unaffected) if there is no card.
+void initFlightLog();
+bool isFlightLogActive();
+const char* getFlightLogName();
+
+// Call every main-loop tick: logs this tick's snapshot and writes at most one sector.
+void updateFlightLog(uint32_t now_ms);
+
+// Append one binary frame (BIN_FRAME_* type + body) to the log.
+bool flightLogFrame(uint8_t type, const uint8_t* body, size_t len);
+
+// Flush the partial sector, trim the file to its real length and stop logging.
+void closeFlightLog();
+
+void getFlightLogStats(FlightLogStats* out);
+
+// Blocking throughput/latency benchmark on a scratch file (PRELAUNCH only, it
+// stalls the loop for the duration). Returns false if it cannot run.
+bool runFlightLogBenchmark(uint32_t sectors, FlightLogBenchResult* out);
+
+// Stored-log access for the radio downlink (LogDownlink.h). One reader at a time;
+// the file currently being recorded cannot be opened.
+typedef void (*LogListFn)(const char* name, uint32_t size, void* ctx);
+void flightLogList(LogListFn fn, void* ctx);
+bool flightLogOpenRead(const char* name, uint32_t* size);
+int32_t flightLogReadAt(uint32_t offset, uint8_t* buf, size_t len);  // -1 on error, 0 if card busy
+void flightLogCloseRead();
+
+#endif // FLIGHTLOG_H
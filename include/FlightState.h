@@ -26,4 +26,8 @@ void setFlightState(FlightState state);
 // Convert flight state to ASCII string for telemetry
 const char* flightStateToString(FlightState state);
 
+// Vehicle is on the ground (PRELAUNCH, LAUNCH_PAD or LANDED): slow storage work
+// (EEPROM commits, file closes) is allowed.
+bool isGroundState(FlightState state);
+
 #endif // FLIGHTSTATE_H
@@ -0,0 +1,52 @@
+#ifndef LANDINGDETECTOR_H
+#define LANDINGDETECTOR_H
+
+#include <stdint.h>
+
+// Landing detection for the flight state machine (PAYLOAD_RELEASE -> LANDED). Paraglider
+// guidance (LANDED_MODE) reads the same decision, but servos.cpp is compiled out
+// while actuation is disabled.
+//
+// Every main-loop tick during descent feeds one sample of altitude and linear
+// acceleration magnitude (BNO055, gravity removed). Over a sliding window of
+// LAND_WINDOW_SAMPLES ticks the detector keeps the mean and variance of both,
+// updated incrementally as the oldest sample leaves and the newest enters.
+//
+// - Still: altitude std < LAND_ALT_STD_M, acceleration std < LAND_ACCEL_STD_MPS2
+//   and |vertical velocity| < LANDED_VZ_MPS, with a full window.
+// - Impact: an acceleration magnitude above LAND_IMPACT_MPS2. Spikes less than
+//   LAND_IMPACT_WINDOW_MS apart are one impact (peak kept). It counts as touchdown
+//   only if it ended within LAND_IMPACT_WINDOW_MS before the still stretch began,
+//   so a separation or deployment shock high up cannot shorten the confirmation of
+//   a later soft landing. EVT_IMPACT is journaled when an impact counts.
+// - Landed: still continuously for LAND_CONFIRM_MS after a touchdown impact, or
+//   for twice that without one (soft landing, or the IMU missed the spike).
+//   Latched until resetLandingDetector().
+
+static const uint8_t LAND_MAX_WINDOW = 64;
+
+struct LandingDetectorStatus {
+    uint8_t fill;            // Samples in the window
+    float altStdM;
+    float accelStdMps2;
+    bool still;
+    uint32_t stillSinceMs;   // Start of the current still stretch
+    bool impact;             // The current still stretch follows a touchdown impact
+    bool impactSeen;         // Any impact since reset; impactMs/impactPeakMps2 are the latest
+    uint32_t impactMs;       // Last spike of the latest impact
+    float impactPeakMps2;
+    bool landed;
+    uint32_t landedMs;
+};
+
+// Forget everything (LAUNCH_PAD entry).
+void resetLandingDetector();
+
+// Feed one tick; returns isLandingConfirmed().
+bool updateLandingDetector(float altitude, float accelMagnitude, float verticalVel, uint32_t nowMs);
+
+bool isLandingConfirmed();
+
+void getLandingDetectorStatus(LandingDetectorStatus* out);
+
+#endif // LANDINGDETECTOR_H
@@ -0,0 +1,43 @@
+#ifndef LINKSCHEDULER_H
+#define LINKSCHEDULER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Outbound traffic classes sharing the 9600-baud transparent XBee link, highest
+// priority first. LINK_TELEMETRY (the mandated 1 Hz packet) is always admitted;
+// every other class only gets airtime left over after telemetry is reserved.
+enum LinkClass {
+    LINK_TELEMETRY,  // Mandated CSV telemetry line (X4, C9)
+    LINK_ACK,        // Command replies / acknowledgements
+    LINK_BURST,      // Event-triggered burst data
+    LINK_STREAM,     // High-rate binary telemetry side stream (BIN)
+    LINK_DEBUG,      // Debug lines such as [GPS_RAW]
+    LINK_LOG,        // Stored-log downlink
+    LINK_CLASS_COUNT
+};
+
+// Per-class accounting since initLinkScheduler().
+struct LinkClassStats {
+    uint32_t allocatedBytes;   // Bytes admitted to the XBee TX queue
+    uint32_t allocatedFrames;
+    uint32_t droppedBytes;     // Bytes refused (no airtime or TX queue full)
+    uint32_t droppedFrames;
+};
+
+// Initialize the scheduler (call after initXBee)
+void initLinkScheduler();
+
+// Submit one whole frame for the given class. Returns false if it was dropped.
+bool linkSubmit(LinkClass cls, const uint8_t* data, size_t length);
+
+// Largest frame the class could submit right now without being dropped.
+// Producers with flexible frame sizes (log downlink, bursts) use this to size chunks.
+size_t linkAvailableBytes(LinkClass cls);
+
+// Per-second byte budget derived from the XBee baud rate (after margin).
+uint32_t linkBytesPerSecond();
+
+void linkGetClassStats(LinkClass cls, LinkClassStats* out);
+
+#endif // LINKSCHEDULER_H
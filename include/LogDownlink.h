@@ -0,0 +1,52 @@
+#ifndef LOGDOWNLINK_H
+#define LOGDOWNLINK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Chunked, resumable downlink of stored logs (SD FLTnn.BIN and black-box
+// BBnnnnnn.BIN) over the XBee, driven by LOG,LIST / LOG,GET / LOG,ACK / LOG,STOP.
+// Data goes out as BIN_FRAME_LOG chunks on LINK_LOG (lowest priority, spare
+// airtime only). At most LOG_DL_WINDOW_BYTES may be outstanding past the last
+// acknowledged offset; if no ACK arrives for LOG_DL_ACK_TIMEOUT_MS the sender goes
+// back to that offset. A transfer broken off entirely is resumed by the ground
+// issuing LOG,GET again from its own last contiguous offset.
+
+static const uint32_t LOG_DL_WINDOW_BYTES = 1536;     // ~2 s of spare airtime
+static const uint32_t LOG_DL_ACK_TIMEOUT_MS = 3000;
+static const uint32_t LOG_DL_ABORT_MS = 30000;        // Give up after this long without an ACK
+static const size_t LOG_DL_MIN_CHUNK = 32;            // Wait for airtime rather than send tiny chunks
+static const uint8_t LOG_DL_LIST_PER_LINE = 6;
+
+struct LogDownlinkStatus {
+    bool active;
+    uint8_t xferId;
+    char name[16];
+    uint32_t ackOffset;     // Everything below this is confirmed by the ground
+    uint32_t sendOffset;    // Next byte to send
+    uint32_t endOffset;     // One past the last byte of the requested range
+    uint32_t chunksSent;
+    uint32_t bytesSent;     // Including retransmissions
+    uint32_t rewinds;       // Go-back-to-ACK events
+};
+
+void initLogDownlink();
+
+// Format one "[LOGLS] ..." line with up to LOG_DL_LIST_PER_LINE entries starting at
+// index first (SD logs first, then black-box segments). Returns the line length.
+size_t logDownlinkList(uint16_t first, char* out, size_t cap);
+
+// Start sending name[offset, offset+length) (length 0 = to end of file). Replaces
+// any transfer in progress.
+bool logDownlinkStart(const char* name, uint32_t offset, uint32_t length);
+
+// Ground confirms all bytes below offset were received intact.
+bool logDownlinkAck(uint32_t offset);
+
+void logDownlinkStop();
+void getLogDownlinkStatus(LogDownlinkStatus* out);
+
+// Call every main-loop tick: sends at most one chunk.
+void updateLogDownlink(uint32_t now_ms);
+
+#endif // LOGDOWNLINK_H
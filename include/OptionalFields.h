@@ -0,0 +1,41 @@
+#ifndef OPTIONALFIELDS_H
+#define OPTIONALFIELDS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "CsvWriter.h"
+
+// OPTIONAL_DATA registry (rules §3.1.1.1: extra comma-delimited fields on the SAME
+// telemetry line, after CMD_ECHO).
+//
+// Each module declares its columns in its own header as an X-macro list,
+// <MODULE>_OPTIONAL_FIELDS(FIXED, UINT), whose entries are
+//     FIXED("NAME", decimals, getter)   bool getter(const SensorSnapshot&, float* out)
+//     UINT("NAME", getter)              bool getter(const SensorSnapshot&, uint32_t* out)
+// and adds it to OPTIONAL_FIELD_LIST in OptionalFields.cpp. The list is expanded
+// into one constexpr table, so emitting the columns is a straight walk over a
+// static array; the GCS CSV header row is generated from the same table.
+// Getters read the packet's SensorSnapshot, so optional columns describe the same
+// instant as the mandated ones. A getter returning false sends an empty field so
+// column positions never shift.
+
+struct SensorSnapshot;
+
+struct OptionalField {
+    const char* name;
+    uint8_t decimals;                  // Fixed-point resolution (FIXED fields)
+    bool (*getFixed)(const SensorSnapshot& snap, float* out);  // Exactly one getter is set
+    bool (*getUInt)(const SensorSnapshot& snap, uint32_t* out);
+};
+
+// Number of OPTIONAL_DATA columns appended to every telemetry line.
+size_t optionalFieldCount();
+const OptionalField* optionalFieldAt(size_t index);
+
+// Append all OPTIONAL_DATA columns (values) for one snapshot to a telemetry line.
+void writeOptionalFields(CsvWriter* w, const SensorSnapshot& snap);
+
+// Append all OPTIONAL_DATA column names (for the GCS CSV header row).
+void writeOptionalFieldNames(CsvWriter* w);
+
+#endif // OPTIONALFIELDS_H
@@ -0,0 +1,130 @@
+#ifndef PARAMS_H
+#define PARAMS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Runtime-tunable flight parameters (PRM command).
+//
+// Every guidance / state-machine constant that needs field tuning is one entry of
+// PARAM_LIST: ID, name, type, default, min, max. Values live in one flat float
+// array indexed by ParamId, so hot paths read param(PRM_X) - a single array load,
+// no lookup. PRM,SET writes through to EEPROM on the ground; in flight the new
+// value applies at once but is saved only after landing (updateParams). At boot each stored value is used
+// if this build still has a parameter of that name and type (and the value is in
+// bounds), so adding a parameter keeps every other tuned value.
+//
+// New parameters are appended at the end (IDs are positions; the GCS may cache them).
+// PARAM_U32 entries hold whole numbers (ms, counts) and are exact in a float up to 2^24.
+
+enum ParamType {
+    PARAM_FLOAT,
+    PARAM_U32
+};
+
+#define PARAM_LIST(X)                                                                 \
+    /* StateLogic.cpp - flight regime transitions */                                  \
+    X(PRM_ASCENT_THRESHOLD_M,   "ASCENT_THRESHOLD_M",   PARAM_FLOAT, 5.0f,   0.5f, 50.0f)  \
+    X(PRM_PROBE_RELEASE_FRAC,   "PROBE_RELEASE_FRAC",   PARAM_FLOAT, 0.8f,   0.3f, 0.95f)  \
+    X(PRM_PAYLOAD_RELEASE_ALT_M, "PAYLOAD_RELEASE_ALT_M", PARAM_FLOAT, 2.0f, 0.0f, 50.0f)  \
+    /* servos.cpp - paraglider descent stages (compiled out while actuation is off) */ \
+    X(PRM_STABILIZE_TIME_MS,    "STABILIZE_TIME_MS",    PARAM_U32,   3500,   0,    20000)  \
+    X(PRM_MIN_STAGE_DWELL_MS,   "MIN_STAGE_DWELL_MS",   PARAM_U32,   1200,   0,    10000)  \
+    X(PRM_FAR_DISTANCE_M,       "FAR_DISTANCE_M",       PARAM_FLOAT, 40.0f,  5.0f, 500.0f) \
+    X(PRM_SPIRAL_DISTANCE_M,    "SPIRAL_DISTANCE_M",    PARAM_FLOAT, 15.0f,  1.0f, 200.0f) \
+    X(PRM_FINAL_APPROACH_ALT_M, "FINAL_APPROACH_ALT_M", PARAM_FLOAT, 15.0f,  1.0f, 200.0f) \
+    X(PRM_RELEASE_ZONE_ALT_M,   "RELEASE_ZONE_ALT_M",   PARAM_FLOAT, 5.0f,   0.5f, 100.0f) \
+    X(PRM_EGG_RELEASE_ALT_M,    "EGG_RELEASE_ALT_M",    PARAM_FLOAT, 2.0f,   0.0f, 50.0f)  \
+    X(PRM_MIN_VALID_SATS,       "MIN_VALID_SATS",       PARAM_U32,   4,      0,    24)     \
+    X(PRM_MAX_SPIRAL_TIME_MS,   "MAX_SPIRAL_TIME_MS",   PARAM_U32,   6000,   0,    60000)  \
+    /* servos.cpp - lateral guidance */                                               \
+    X(PRM_GYRO_DAMP_GAIN_FAR,   "GYRO_DAMP_GAIN_FAR",   PARAM_FLOAT, 0.30f,  0.0f, 2.0f)   \
+    X(PRM_GYRO_DAMP_GAIN_MID,   "GYRO_DAMP_GAIN_MID",   PARAM_FLOAT, 0.40f,  0.0f, 2.0f)   \
+    X(PRM_GYRO_DAMP_GAIN_FINAL, "GYRO_DAMP_GAIN_FINAL", PARAM_FLOAT, 0.50f,  0.0f, 2.0f)   \
+    X(PRM_HEADING_KP_FAR,       "HEADING_KP_FAR",       PARAM_FLOAT, 0.32f,  0.0f, 2.0f)   \
+    X(PRM_HEADING_KP_MID,       "HEADING_KP_MID",       PARAM_FLOAT, 0.38f,  0.0f, 2.0f)   \
+    X(PRM_HEADING_KP_SPIRAL,    "HEADING_KP_SPIRAL",    PARAM_FLOAT, 0.42f,  0.0f, 2.0f)   \
+    X(PRM_HEADING_KP_FINAL,     "HEADING_KP_FINAL",     PARAM_FLOAT, 0.28f,  0.0f, 2.0f)   \
+    X(PRM_HEADING_KP_RELEASE,   "HEADING_KP_RELEASE",   PARAM_FLOAT, 0.24f,  0.0f, 2.0f)   \
+    X(PRM_BASE_TURN_FAR,        "BASE_TURN_FAR",        PARAM_FLOAT, 10.0f,  0.0f, 30.0f)  \
+    X(PRM_BASE_TURN_MID,        "BASE_TURN_MID",        PARAM_FLOAT, 14.0f,  0.0f, 30.0f)  \
+    X(PRM_BASE_TURN_SPIRAL,     "BASE_TURN_SPIRAL",     PARAM_FLOAT, 16.0f,  0.0f, 30.0f)  \
+    X(PRM_BASE_TURN_FINAL,      "BASE_TURN_FINAL",      PARAM_FLOAT, 8.0f,   0.0f, 30.0f)  \
+    /* servos.cpp - vertical rate PI and braking */                                   \
+    X(PRM_VZ_CMD_MPS,           "VZ_CMD_MPS",           PARAM_FLOAT, -5.0f, -15.0f, 0.0f)  \
+    X(PRM_VZ_LPF_ALPHA,         "VZ_LPF_ALPHA",         PARAM_FLOAT, 0.35f,  0.01f, 1.0f)  \
+    X(PRM_VZ_KP,                "VZ_KP",                PARAM_FLOAT, 0.85f,  0.0f, 5.0f)   \
+    X(PRM_VZ_KI,                "VZ_KI",                PARAM_FLOAT, 0.20f,  0.0f, 5.0f)   \
+    X(PRM_VZ_INT_MAX,           "VZ_INT_MAX",           PARAM_FLOAT, 4.0f,   0.0f, 20.0f)  \
+    X(PRM_VZ_DELTA_CLAMP,       "VZ_DELTA_CLAMP",       PARAM_FLOAT, 7.0f,   0.0f, 30.0f)  \
+    X(PRM_SYM_BRAKE_SPIRAL,     "SYM_BRAKE_SPIRAL",     PARAM_FLOAT, 3.0f,   0.0f, 30.0f)  \
+    X(PRM_SYM_BRAKE_FINAL,      "SYM_BRAKE_FINAL",      PARAM_FLOAT, 4.0f,   0.0f, 30.0f)  \
+    X(PRM_SYM_BRAKE_RELEASE,    "SYM_BRAKE_RELEASE",    PARAM_FLOAT, 2.0f,   0.0f, 30.0f)  \
+    X(PRM_LANDED_VZ_MPS,        "LANDED_VZ_MPS",        PARAM_FLOAT, 0.3f,   0.01f, 5.0f)   \
+    /* Timing.cpp - GPS clock discipline */                                           \
+    X(PRM_GPS_TIME_LATENCY_MS,  "GPS_TIME_LATENCY_MS",  PARAM_U32,   0,      0,    900)    \
+    /* ApogeeDetector.cpp - apogee vote */                                            \
+    X(PRM_APOGEE_VEL_ALPHA,     "APOGEE_VEL_ALPHA",     PARAM_FLOAT, 0.3f,   0.01f, 1.0f)  \
+    X(PRM_APOGEE_DROP_SIGMA,    "APOGEE_DROP_SIGMA",    PARAM_FLOAT, 4.0f,   0.0f, 20.0f)  \
+    X(PRM_APOGEE_MIN_DROP_M,    "APOGEE_MIN_DROP_M",    PARAM_FLOAT, 1.5f,   0.1f, 50.0f)  \
+    X(PRM_APOGEE_VOTE_N,        "APOGEE_VOTE_N",        PARAM_U32,   5,      1,    32)     \
+    X(PRM_APOGEE_VOTE_M,        "APOGEE_VOTE_M",        PARAM_U32,   7,      1,    32)     \
+    /* LandingDetector.cpp - stillness window and impact */                           \
+    X(PRM_LAND_WINDOW_SAMPLES,  "LAND_WINDOW_SAMPLES",  PARAM_U32,   50,     4,    64)     \
+    X(PRM_LAND_ALT_STD_M,       "LAND_ALT_STD_M",       PARAM_FLOAT, 0.15f,  0.01f, 5.0f)  \
+    X(PRM_LAND_ACCEL_STD_MPS2,  "LAND_ACCEL_STD_MPS2",  PARAM_FLOAT, 0.3f,   0.01f, 10.0f) \
+    X(PRM_LAND_IMPACT_MPS2,     "LAND_IMPACT_MPS2",     PARAM_FLOAT, 20.0f,  2.0f, 160.0f) \
+    X(PRM_LAND_CONFIRM_MS,      "LAND_CONFIRM_MS",      PARAM_U32,   2000,   0,    30000)  \
+    X(PRM_LAND_IMPACT_WINDOW_MS, "LAND_IMPACT_WINDOW_MS", PARAM_U32,  3000,   0,    30000)
+
+#define PARAM_ENUM_ENTRY(id, name, type, def, lo, hi) id,
+enum ParamId {
+    PARAM_LIST(PARAM_ENUM_ENTRY)
+    PARAM_COUNT
+};
+#undef PARAM_ENUM_ENTRY
+
+struct ParamInfo {
+    const char* name;
+    ParamType type;
+    float defaultValue;
+    float minValue;
+    float maxValue;
+};
+
+// Current values, indexed by ParamId (read via param()/paramU32()).
+extern float paramValues[PARAM_COUNT];
+
+static inline float param(ParamId id) {
+    return paramValues[id];
+}
+
+static inline uint32_t paramU32(ParamId id) {
+    return (uint32_t)paramValues[id];
+}
+
+// Load stored values (or defaults) - call first in setup().
+void initParams();
+
+const ParamInfo* paramInfo(ParamId id);
+
+// ID from a name ("VZ_KP") or a decimal ID ("27"); false if unknown.
+bool paramFind(const char* nameOrId, ParamId* out);
+
+// Bounds/type-checked set; persisted to EEPROM when changed (deferred in flight).
+// False if rejected.
+bool paramSet(ParamId id, float value);
+
+// Restore every parameter to its default and persist (deferred in flight).
+void paramResetAll();
+
+// True while a change made in flight is waiting to be saved.
+bool paramsSavePending();
+
+// Save deferred changes once the flight state is a ground state - call periodically.
+void updateParams();
+
+// Format a value the way the parameter's type reads best ("3500", "0.85").
+size_t paramFormat(ParamId id, float value, char* out, size_t cap);
+
+#endif // PARAMS_H
@@ -30,6 +30,10 @@ float getAccelYaw();    // ACCEL_Y
 
 // GPS (required: SN4)
 bool getGPSTime(uint8_t& hour, uint8_t& minute, uint8_t& second);  // UTC time, 1s resolution
+// Latest GPS fix epoch: UTC time of day it reports and the monotonic time
+// (getMonotonicUs) its first NMEA sentence was parsed. Returns a count that
+// increases with every new epoch (0 = none yet / no fix).
+uint32_t getGPSTimeEpoch(uint32_t& msOfDay, uint64_t& arrivalUs);
 float getGPSAltitude();  // Altitude in meters above MSL, resolution 0.1m
 float getGPSLatitude();  // Latitude in decimal degrees, resolution 0.0001°N
 float getGPSLongitude(); // Longitude in decimal degrees, resolution 0.0001°W
@@ -37,6 +41,7 @@ uint8_t getGPSSatellites();  // Number of GPS satellites tracked
 
 // Derived values
 float getVerticalVelocity();  // Vertical velocity in m/s
+uint32_t getAltitudeSampleMs();  // millis() of the latest baro/SIMP altitude sample (0 = none)
 
 // Paraglider guidance: best heading reference for steering (GPS COG preferred; IMU fallback).
 // On success sets *source: 1 = GPS course-over-ground, 2 = BNO055 Euler (heading).
@@ -53,6 +58,51 @@ void setSimulatedPressure(float pressure_pa);  // Pressure in Pascals
 // Update sensor readings (call periodically)
 void updateSensors();
 
+// One consistent set of sensor values from a single updateSensors() pass.
+// Telemetry builds each packet from one snapshot instead of separate getters.
+struct SensorSnapshot {
+    uint32_t captureMs;  // millis() at which these values were read
+    float altitude;      // m AGL
+    float pressure;      // kPa (simulated pressure in simulation mode)
+    float temperature;   // °C
+    float voltage;       // V
+    float current;       // A
+    float gyroR, gyroP, gyroY;     // deg/s
+    float accelR, accelP, accelY;  // m/s²
+    bool gpsTimeValid;
+    uint8_t gpsHour, gpsMinute, gpsSecond;
+    float gpsAltitude;   // m MSL
+    float gpsLatitude;   // deg
+    float gpsLongitude;  // deg
+    uint8_t gpsSatellites;
+    float verticalVelocity;  // m/s, + up
+    bool headingValid;
+    float headingDeg;
+    uint8_t headingSource;   // See getHeadingReferenceDeg
+};
+
+// Copy the values of the last updateSensors() pass (no sensor I/O).
+void captureSensorSnapshot(SensorSnapshot* out);
+
+// OPTIONAL_DATA telemetry adapters (see OptionalFields.h). Return false when the
+// value is unavailable; the column is then sent empty.
+bool optCaptureMs(const SensorSnapshot& snap, uint32_t* out);
+bool optVerticalVelocity(const SensorSnapshot& snap, float* out);
+bool optHeadingDeg(const SensorSnapshot& snap, float* out);
+bool optHeadingSource(const SensorSnapshot& snap, uint32_t* out);
+
+// OPTIONAL_DATA columns owned by the sensors module: FIXED(name, decimals, getter)
+// or UINT(name, getter). Expanded by OptionalFields.cpp into the static table.
+#define SENSORS_OPTIONAL_FIELDS(FIXED, UINT)       \
+    FIXED("VERT_VEL", 1, optVerticalVelocity)      \
+    FIXED("HEADING", 1, optHeadingDeg)             \
+    UINT("HEADING_SRC", optHeadingSource)
+
+// Snapshot timestamp column; a separate list because it was added after the
+// registry shipped, so OptionalFields.cpp appends it at the end.
+#define SNAPSHOT_OPTIONAL_FIELDS(FIXED, UINT)      \
+    UINT("CAPTURE_MS", optCaptureMs)
+
 // Debug: returns the last complete raw NMEA sentence received from the GPS UART.
 // Empty string if nothing has been received yet. For USB Serial debug only.
 const char* getLastNMEASentence();
@@ -2,9 +2,74 @@
 #define STATELOGIC_H
 
 #include <stdint.h>
+#include <stddef.h>
+#include "FlightState.h"
+
+// Flight regime transitions as a table of (state, guard, action, next).
+//
+// Each tick updateFlightState() reads the inputs once, runs the current state's
+// "during" action (bookkeeping that happens every tick, e.g. peak altitude), then
+// evaluates that state's rows in table order: the first guard that passes runs its
+// action and, if next differs from the state, setFlightState(next). At most one row
+// fires per tick. A row whose next equals its state is an in-state step (LAUNCH_PAD
+// entry initialization).
+//
+// Guards are pure functions of FlightInputs and FlightContext so they can be
+// exercised off-target; actions own every side effect (zeroing altitude, cameras,
+// servos, latches). Adding a state means adding rows, not touching the loop.
+
+// Sensor/system readings sampled once per tick.
+struct FlightInputs {
+    float altitude;      // m, pad-relative after zeroAltitude()
+    float verticalVel;   // m/s, positive up
+    uint32_t altitudeSampleMs;  // getAltitudeSampleMs(): changes with each new sample
+    float accelMagnitude;  // m/s², BNO055 linear acceleration (gravity removed)
+    uint32_t nowMs;
+    bool telemetryUp;    // telemetryActive()
+    bool timeSet;        // timeSetComplete()
+};
+
+// Flight bookkeeping shared by guards and actions.
+struct FlightContext {
+    float maxAltitude;        // Peak altitude this flight (for % descent threshold)
+    float launchPadAltitude;
+    bool launchPadInitialized;
+    bool apogeeDetected;      // ApogeeDetector vote passed
+    bool apogeeLatched;
+    bool landed;              // LandingDetector confirmed stillness
+    bool camera1Started;
+    bool camera2Started;
+};
+
+typedef bool (*FlightGuard)(const FlightInputs& in, const FlightContext& ctx);
+typedef void (*FlightAction)(const FlightInputs& in, FlightContext& ctx);
+
+struct FlightTransition {
+    FlightState state;
+    FlightGuard guard;
+    FlightAction action;  // nullptr = none
+    FlightState next;
+    const char* name;
+};
+
+extern const FlightTransition FLIGHT_TRANSITIONS[];
+extern const size_t FLIGHT_TRANSITION_COUNT;
+
+// Per-row record: how often the guard ran and what it cost, and when the row last
+// fired. Guard cost is in CPU cycles on Teensy 4.x (DWT), microseconds elsewhere.
+struct FlightTransitionStats {
+    uint32_t evaluations;
+    uint32_t fired;
+    uint64_t lastFiredUs;    // getMonotonicUs() when it last fired; 0 = never
+    uint32_t lastGuardCycles;
+    uint32_t maxGuardCycles;
+};
 
 // Update the flight state based on current sensor readings
 // Called periodically from main loop
 void updateFlightState(uint32_t now_ms);
 
+// Stats for one table row; false if row is out of range.
+bool getFlightTransitionStats(size_t row, FlightTransitionStats* out);
+
 #endif // STATELOGIC_H
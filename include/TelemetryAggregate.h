@@ -0,0 +1,77 @@
+#ifndef TELEMETRYAGGREGATE_H
+#define TELEMETRYAGGREGATE_H
+
+#include <stdint.h>
+
+// Windowed aggregate telemetry mode (AGG command).
+// While enabled, every 100 Hz loop tick feeds the sensor snapshot into streaming
+// (Welford) accumulators. At each 1 Hz packet the window is closed: the mandated
+// ALTITUDE / GYRO_* / ACCEL_* columns carry the window MEAN and the AGG_* optional
+// columns carry min / max / standard deviation. When disabled, packets carry the
+// instantaneous sample and the AGG_* columns are empty.
+
+struct SensorSnapshot;
+
+enum AggChannel {
+    AGG_ALTITUDE,
+    AGG_GYRO_R,
+    AGG_GYRO_P,
+    AGG_GYRO_Y,
+    AGG_ACCEL_R,
+    AGG_ACCEL_P,
+    AGG_ACCEL_Y,
+    AGG_CHANNEL_COUNT
+};
+
+enum AggStat {
+    AGG_STAT_MIN,
+    AGG_STAT_MAX,
+    AGG_STAT_STDDEV
+};
+
+void initTelemetryAggregate();
+
+void setTelemetryAggregateEnabled(bool enabled);
+bool isTelemetryAggregateEnabled();
+
+// Drop the open window (telemetry switched on: the first packet covers only the
+// interval since then).
+void restartTelemetryAggregateWindow();
+
+// Add one sample to the open window (call every main-loop tick after updateSensors).
+// Nothing is accumulated while telemetry is off.
+void updateTelemetryAggregate();
+
+// Close the open window: replace the channel values in *snap with window means
+// and freeze min/max/stddev for the AGG_* columns. No-op (returns false) when the
+// mode is off or the window is empty.
+bool closeTelemetryAggregateWindow(SensorSnapshot* snap);
+
+// Statistic of the last closed window; false when unavailable.
+bool getTelemetryAggregateStat(AggChannel ch, AggStat stat, float* out);
+
+// OPTIONAL_DATA adapters: one instantiation per (channel, statistic).
+template <AggChannel CH, AggStat STAT>
+bool optAggStat(const SensorSnapshot& snap, float* out) {
+    (void)snap;
+    return getTelemetryAggregateStat(CH, STAT, out);
+}
+bool optAggSamples(const SensorSnapshot& snap, uint32_t* out);
+
+#define AGG_CHANNEL_OPTIONAL_FIELDS(FIXED, NAME, CH)                     \
+    FIXED(NAME "_MIN", 1, (optAggStat<CH, AGG_STAT_MIN>))                \
+    FIXED(NAME "_MAX", 1, (optAggStat<CH, AGG_STAT_MAX>))                \
+    FIXED(NAME "_SD", 1, (optAggStat<CH, AGG_STAT_STDDEV>))
+
+// OPTIONAL_DATA columns owned by the aggregate mode (empty unless AGG,ON).
+#define AGGREGATE_OPTIONAL_FIELDS(FIXED, UINT)                          \
+    UINT("AGG_N", optAggSamples)                                         \
+    AGG_CHANNEL_OPTIONAL_FIELDS(FIXED, "ALT", AGG_ALTITUDE)              \
+    AGG_CHANNEL_OPTIONAL_FIELDS(FIXED, "GYRO_R", AGG_GYRO_R)             \
+    AGG_CHANNEL_OPTIONAL_FIELDS(FIXED, "GYRO_P", AGG_GYRO_P)             \
+    AGG_CHANNEL_OPTIONAL_FIELDS(FIXED, "GYRO_Y", AGG_GYRO_Y)             \
+    AGG_CHANNEL_OPTIONAL_FIELDS(FIXED, "ACCEL_R", AGG_ACCEL_R)           \
+    AGG_CHANNEL_OPTIONAL_FIELDS(FIXED, "ACCEL_P", AGG_ACCEL_P)           \
+    AGG_CHANNEL_OPTIONAL_FIELDS(FIXED, "ACCEL_Y", AGG_ACCEL_Y)
+
+#endif // TELEMETRYAGGREGATE_H
@@ -15,6 +15,17 @@ bool timeSetComplete();  // Check if time synchronization is complete
 // Returns true if time is valid, false otherwise
 bool getMissionTime(uint8_t& hour, uint8_t& minute, uint8_t& second);
 
+// Mission time of day in milliseconds (0..86399999) / microseconds, same clock as
+// getMissionTime(). Use these for event and sensor timestamps.
+bool getMissionTimeMs(uint32_t& msOfDay);
+bool getMissionTimeUs(uint64_t& usOfDay);
+
+// Monotonic microseconds since boot, 64-bit (never wraps). Main-loop context only.
+uint64_t getMonotonicUs();
+
+// Parse "hh:mm:ss" or "hh:mm:ss.mmm" into milliseconds of the day.
+bool parseTimeOfDayMs(const char* timeStr, uint32_t& msOfDay);
+
 // Set mission time from UTC string "hh:mm:ss" or GPS (required: ST command)
 bool setMissionTime(const char* timeStr);  // Format: "13:35:59" or "GPS"
 bool setMissionTimeFromGPS();
@@ -23,8 +34,35 @@ bool setMissionTimeFromGPS();
 uint32_t getCurrentTimeMs();
 
 // Save/restore mission time to/from persistent storage (required: F2)
+// Save stores the set time and its offset from the battery-backed SNVS RTC;
+// restore continues mission time from the RTC (falls back to the set time if the
+// RTC stopped).
 void saveMissionTime();  // Save to EEPROM or flash
 void restoreMissionTime();  // Restore from EEPROM or flash
+bool isMissionTimeFromRtc();  // Mission time is anchored to the RTC
+
+// GPS clock discipline (runs inside updateTiming once mission time is set): at
+// every GPS fix epoch the mission clock is compared with GPS time, and a PI loop
+// estimates the crystal frequency offset and slews the UTC mapping - no steps.
+// If ST left mission time more than 1 s from GPS, that offset is kept and only
+// the frequency is corrected. PRM GPS_TIME_LATENCY_MS compensates the delay from
+// the fix epoch to its NMEA sentence arriving.
+struct ClockDisciplineStatus {
+    bool locked;            // Enough consecutive epochs for the estimate to be meaningful
+    float driftPpm;         // Estimated crystal error (+ = Teensy clock runs fast)
+    int32_t phaseErrorUs;   // Last measured error vs the steering target
+    int32_t slewPpb;        // Rate currently applied to the UTC mapping
+    uint32_t epochs;
+    uint32_t rejected;      // Outlier epochs ignored
+};
+void getClockDiscipline(ClockDisciplineStatus* out);
+
+// OPTIONAL_DATA telemetry adapter (see OptionalFields.h); empty until locked.
+struct SensorSnapshot;
+bool optClockDriftPpm(const SensorSnapshot& snap, float* out);
+
+#define TIMING_OPTIONAL_FIELDS(FIXED, UINT) \
+    FIXED("CLK_DRIFT_PPM", 2, optClockDriftPpm)
 
 // Update timing system (call periodically)
 void updateTiming();
@@ -4,19 +4,79 @@
 #include <stddef.h>
 #include <stdint.h>
 
+// Outbound frame priority for the TX queue.
+// HIGH frames (mandated telemetry) may use the whole ring. LOW frames (debug lines
+// and other optional traffic) are refused once free space would drop below the
+// high-priority reserve, so they can never crowd out the next telemetry packet.
+enum XBeePriority {
+    XBEE_PRIORITY_HIGH,
+    XBEE_PRIORITY_LOW
+};
+
+// TX queue diagnostics (bytes are counted at the UART, before the radio).
+struct XBeeTxStats {
+    uint32_t queuedBytes;      // Bytes waiting in the software ring
+    uint32_t inFlightBytes;    // queuedBytes + bytes already handed to the UART FIFO
+    uint32_t peakQueuedBytes;  // High-water mark of queuedBytes since init
+    uint32_t framesQueued;     // Frames accepted into the ring
+    uint32_t framesDropped;    // Frames refused because the ring was full
+    uint32_t bytesDropped;     // Payload bytes of refused frames
+};
+
+// RX line queue diagnostics.
+struct XBeeRxStats {
+    uint32_t linesQueued;      // Complete lines accepted into the queue
+    uint32_t linesDropped;     // Lines lost because the queue was full
+    uint32_t linesTooLong;     // Lines discarded for exceeding the line buffer
+    uint8_t queuedLines;       // Lines waiting right now
+    uint8_t peakQueuedLines;
+};
+
 // Initialize XBee communication module
 void initXBee();
 
 // Check if XBee is connected/ready
 bool xbeeReady();
 
-// Send data via XBee
+// Raw UART throughput in bytes per second (8N1: baud / 10)
+uint32_t xbeeBytesPerSecond();
+
+// Send data via XBee (queued at HIGH priority; never blocks)
 void xbeeSend(const uint8_t* data, size_t length);
 
-// Receive data via XBee (non-blocking)
+// Queue one whole frame for transmission. Never blocks: returns false (and counts
+// the drop) if the frame does not fit for its priority. Frames are never split.
+bool xbeeSendFrame(const uint8_t* data, size_t length, XBeePriority priority);
+
+// Bytes waiting in the TX ring / waiting anywhere before the wire.
+size_t xbeeTxQueueDepth();
+size_t xbeeTxBytesInFlight();
+void xbeeGetTxStats(XBeeTxStats* out);
+
+// OPTIONAL_DATA telemetry adapters (see OptionalFields.h); link state, snapshot unused.
+struct SensorSnapshot;
+bool optTxInFlight(const SensorSnapshot& snap, uint32_t* out);
+bool optTxDropped(const SensorSnapshot& snap, uint32_t* out);
+
+// OPTIONAL_DATA columns owned by the XBee module (radio queue health).
+#define XBEE_OPTIONAL_FIELDS(FIXED, UINT)   \
+    UINT("TX_INFLIGHT", optTxInFlight)      \
+    UINT("TX_DROPS", optTxDropped)
+
+// Receive data via XBee (non-blocking): oldest queued command line, if any.
 bool xbeeReceive(uint8_t* buffer, size_t* length);
 
-// Update XBee communication (call periodically)
+// As xbeeReceive(), also returning the micros() timestamp at which the line's
+// terminator arrived (for receive-to-execute latency).
+bool xbeeReceiveCommand(uint8_t* buffer, size_t* length, uint32_t* rxMicros);
+
+// Split any received bytes into queued lines. Runs from serialEvent5(); only
+// needs calling directly from code that blocks without yield().
+void xbeePollRx();
+void xbeeGetRxStats(XBeeRxStats* out);
+
+// Update XBee communication (call periodically); drains the TX ring into the UART
+// without ever waiting for space.
 void updateXBee();
 
 #endif // XBEE_H
@@ -1,6 +1,7 @@
 #ifndef TELEMETRY_H
 #define TELEMETRY_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 // Initialize telemetry system
@@ -37,6 +38,21 @@ const char* getCommandEcho();
 //         GPS_TIME, GPS_ALTITUDE, GPS_LATITUDE, GPS_LONGITUDE, GPS_SATS, CMD_ECHO [,OPTIONAL_DATA]
 void sendTelemetry();
 
+// GCS CSV header row (mandated names, then OPTIONAL_DATA names from the registry),
+// terminated with "\r\n". Returns length, 0 if it does not fit.
+size_t formatTelemetryHeader(char* buf, size_t cap);
+
+// Time spent formatting the last telemetry packet (microseconds), for profiling.
+uint32_t getTelemetryBuildMicros();
+
+// OPTIONAL_DATA telemetry adapter (see OptionalFields.h): build time of the
+// previous packet (a packet cannot carry its own). Empty before the first packet.
+struct SensorSnapshot;
+bool optTelemetryBuildMicros(const SensorSnapshot& snap, uint32_t* out);
+
+#define TELEMETRY_OPTIONAL_FIELDS(FIXED, UINT) \
+    UINT("TLM_BUILD_US", optTelemetryBuildMicros)
+
 // Update telemetry system (call periodically)
 void updateTelemetry();
 
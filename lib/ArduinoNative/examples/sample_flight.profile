@@ -0,0 +1,14 @@
+# Sample flight for the native build (--profile).
+# t_s  altitude_m  [ax ay az linear acceleration, m/s²]; linearly interpolated.
+0      0
+20     0
+20.5   40     0 0 60
+23     380    0 0 25
+27     680    0 0 -9
+29     720    0 0 -9.8
+31     705    0 0 -2
+# Descent at ~10 m/s, touchdown shock at 101.6 s
+100    15     0 0 0.3
+101.5  0.5    0 0 0.2
+101.6  0      0 0 35
+101.7  0      0 0 0
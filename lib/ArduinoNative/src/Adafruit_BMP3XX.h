@@ -0,0 +1,38 @@
+#ifndef ADAFRUIT_BMP3XX_H
+#define ADAFRUIT_BMP3XX_H
+
+// BMP390 for [env:native]: pressure is the standard atmosphere at the simulated
+// altitude (the inverse of the FSW's barometric formula) plus baro noise.
+
+#include <Wire.h>
+#include <stdint.h>
+
+#define BMP3_NO_OVERSAMPLING 0
+#define BMP3_OVERSAMPLING_2X 1
+#define BMP3_OVERSAMPLING_4X 2
+#define BMP3_OVERSAMPLING_8X 3
+#define BMP3_OVERSAMPLING_16X 4
+#define BMP3_OVERSAMPLING_32X 5
+#define BMP3_IIR_FILTER_DISABLE 0
+#define BMP3_IIR_FILTER_COEFF_1 1
+#define BMP3_IIR_FILTER_COEFF_3 2
+#define BMP3_IIR_FILTER_COEFF_7 3
+#define BMP3_ODR_200_HZ 0
+#define BMP3_ODR_100_HZ 1
+#define BMP3_ODR_50_HZ 2
+#define BMP3_ODR_25_HZ 3
+
+class Adafruit_BMP3XX {
+public:
+    bool begin_I2C(uint8_t address = 0x77, TwoWire* wire = &Wire);
+    bool setTemperatureOversampling(uint8_t os) { (void)os; return true; }
+    bool setPressureOversampling(uint8_t os) { (void)os; return true; }
+    bool setIIRFilterCoeff(uint8_t fs) { (void)fs; return true; }
+    bool setOutputDataRate(uint8_t odr) { (void)odr; return true; }
+    bool performReading();
+
+    double temperature = 0.0;  // °C
+    double pressure = 0.0;     // Pa
+};
+
+#endif // ADAFRUIT_BMP3XX_H
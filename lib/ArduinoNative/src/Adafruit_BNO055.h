@@ -0,0 +1,36 @@
+#ifndef ADAFRUIT_BNO055_H
+#define ADAFRUIT_BNO055_H
+
+// BNO055 for [env:native]: linear acceleration, rates and heading from NativeWorld.
+
+#include <Adafruit_Sensor.h>
+#include <Wire.h>
+#include <stdint.h>
+
+class Adafruit_BNO055 {
+public:
+    typedef enum {
+        OPERATION_MODE_CONFIG = 0x00,
+        OPERATION_MODE_IMUPLUS = 0x08,
+        OPERATION_MODE_NDOF = 0x0C,
+    } adafruit_bno055_opmode_t;
+
+    typedef enum {
+        VECTOR_ACCELEROMETER = 0x08,
+        VECTOR_MAGNETOMETER = 0x0E,
+        VECTOR_GYROSCOPE = 0x14,
+        VECTOR_EULER = 0x1A,
+        VECTOR_LINEARACCEL = 0x28,
+        VECTOR_GRAVITY = 0x2E,
+    } adafruit_vector_type_t;
+
+    Adafruit_BNO055(int32_t sensorID = -1, uint8_t address = 0x28, TwoWire* wire = &Wire);
+    bool begin(adafruit_bno055_opmode_t mode = OPERATION_MODE_NDOF);
+    void setExtCrystalUse(bool useExternal) { (void)useExternal; }
+    bool getEvent(sensors_event_t* event, adafruit_vector_type_t type);
+
+private:
+    int32_t sensorID;
+};
+
+#endif // ADAFRUIT_BNO055_H
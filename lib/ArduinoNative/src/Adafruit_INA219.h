@@ -0,0 +1,19 @@
+#ifndef ADAFRUIT_INA219_H
+#define ADAFRUIT_INA219_H
+
+// INA219 for [env:native]: battery bus voltage and current from NativeWorld.
+
+#include <Wire.h>
+#include <stdint.h>
+
+class Adafruit_INA219 {
+public:
+    explicit Adafruit_INA219(uint8_t address = 0x40) { (void)address; }
+    bool begin(TwoWire* wire = &Wire);
+    float getBusVoltage_V();
+    float getShuntVoltage_mV();
+    float getCurrent_mA();
+    float getPower_mW();
+};
+
+#endif // ADAFRUIT_INA219_H
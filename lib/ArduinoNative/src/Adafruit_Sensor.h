@@ -0,0 +1,42 @@
+#ifndef ADAFRUIT_SENSOR_H
+#define ADAFRUIT_SENSOR_H
+
+// Subset of the Adafruit Unified Sensor event types for [env:native].
+
+#include <stdint.h>
+
+typedef struct {
+    union {
+        float v[3];
+        struct {
+            float x;
+            float y;
+            float z;
+        };
+        struct {
+            float roll;
+            float pitch;
+            float heading;
+        };
+    };
+    int8_t status;
+    uint8_t reserved[3];
+} sensors_vec_t;
+
+typedef struct {
+    int32_t version;
+    int32_t sensor_id;
+    int32_t type;
+    int32_t reserved0;
+    int32_t timestamp;
+    union {
+        float data[4];
+        sensors_vec_t acceleration;
+        sensors_vec_t magnetic;
+        sensors_vec_t orientation;
+        sensors_vec_t gyro;
+        float temperature;
+    };
+} sensors_event_t;
+
+#endif // ADAFRUIT_SENSOR_H
@@ -0,0 +1,373 @@
+// Virtual clock, Print, UART model and IntervalTimer for [env:native] (see Arduino.h).
+#include "Arduino.h"
+#include <stdarg.h>
+
+static uint64_t nowUs = 0;
+
+// ---- IntervalTimer (fired from nativeAdvanceMicros) ----
+
+static const int INTERVAL_TIMER_SLOTS = 4;
+
+struct TimerSlot {
+    void (*callback)();
+    uint32_t periodUs;
+    uint64_t nextUs;
+    bool active;
+};
+static TimerSlot timerSlots[INTERVAL_TIMER_SLOTS];
+static bool inTimerCallback = false;
+
+bool IntervalTimer::begin(void (*callback)(), uint32_t periodUs) {
+    if (callback == nullptr || periodUs == 0) return false;
+    if (slot < 0) {
+        for (int i = 0; i < INTERVAL_TIMER_SLOTS; i++) {
+            if (!timerSlots[i].active) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot < 0) return false;  // All four PIT channels in use
+    }
+    TimerSlot& t = timerSlots[slot];
+    t.callback = callback;
+    t.periodUs = periodUs;
+    t.nextUs = nowUs + periodUs;
+    t.active = true;
+    return true;
+}
+
+void IntervalTimer::update(uint32_t periodUs) {
+    // Takes effect after the current period, as on the PIT.
+    if (slot >= 0 && periodUs > 0) timerSlots[slot].periodUs = periodUs;
+}
+
+void IntervalTimer::end() {
+    if (slot >= 0) {
+        timerSlots[slot].active = false;
+        slot = -1;
+    }
+}
+
+uint64_t nativeMicros64() {
+    return nowUs;
+}
+
+void nativeAdvanceMicros(uint64_t us) {
+    uint64_t target = nowUs + us;
+    // Fire due timers in time order; a callback sees micros() at its own deadline.
+    while (!inTimerCallback) {
+        int due = -1;
+        for (int i = 0; i < INTERVAL_TIMER_SLOTS; i++) {
+            if (timerSlots[i].active && timerSlots[i].nextUs <= target &&
+                (due < 0 || timerSlots[i].nextUs < timerSlots[due].nextUs)) {
+                due = i;
+            }
+        }
+        if (due < 0) break;
+        TimerSlot& t = timerSlots[due];
+        if (t.nextUs > nowUs) nowUs = t.nextUs;
+        t.nextUs += t.periodUs;
+        inTimerCallback = true;
+        t.callback();
+        inTimerCallback = false;
+    }
+    if (target > nowUs) nowUs = target;
+}
+
+uint32_t millis() {
+    return (uint32_t)(nowUs / 1000);
+}
+
+uint32_t micros() {
+    return (uint32_t)nowUs;
+}
+
+void delay(uint32_t ms) {
+    // The Teensy core yields while it waits, so serialEvent handlers keep running.
+    while (ms-- > 0) {
+        nativeAdvanceMicros(1000);
+        yield();
+    }
+}
+
+void delayMicroseconds(uint32_t us) {
+    nativeAdvanceMicros(us);
+}
+
+// Teensy core: yield() runs serialEventN() for each port with data waiting.
+void serialEvent1() __attribute__((weak));
+void serialEvent2() __attribute__((weak));
+void serialEvent3() __attribute__((weak));
+void serialEvent4() __attribute__((weak));
+void serialEvent5() __attribute__((weak));
+void serialEvent6() __attribute__((weak));
+void serialEvent7() __attribute__((weak));
+void serialEvent8() __attribute__((weak));
+
+void yield() {
+    static bool running = false;
+    if (running) return;  // Not re-entered from a handler's own delay()
+    running = true;
+    HardwareSerial* ports[] = { &Serial1, &Serial2, &Serial3, &Serial4,
+                                &Serial5, &Serial6, &Serial7, &Serial8 };
+    void (*events[])() = { serialEvent1, serialEvent2, serialEvent3, serialEvent4,
+                           serialEvent5, serialEvent6, serialEvent7, serialEvent8 };
+    for (int i = 0; i < 8; i++) {
+        if (events[i] != nullptr && ports[i]->available() > 0) events[i]();
+    }
+    running = false;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    (void)pin;
+    (void)value;
+}
+
+int digitalRead(uint8_t pin) {
+    (void)pin;
+    return LOW;
+}
+
+// ---- Print ----
+
+size_t Print::write(const uint8_t* buf, size_t len) {
+    size_t n = 0;
+    while (len-- > 0) n += write(*buf++);
+    return n;
+}
+
+size_t Print::printUnsigned(unsigned long long v, int base) {
+    if (base < 2) base = DEC;
+    char buf[8 * sizeof(v) + 1];
+    char* p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    do {
+        unsigned digit = (unsigned)(v % base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        v /= base;
+    } while (v != 0);
+    return write(p);
+}
+
+size_t Print::printSigned(long long v, int base) {
+    if (base == DEC && v < 0) {
+        size_t n = write((uint8_t)'-');
+        return n + printUnsigned((unsigned long long)(-(v + 1)) + 1, base);
+    }
+    return printUnsigned((unsigned long long)v, base);
+}
+
+size_t Print::print(double v, int digits) {
+    if (isnan(v)) return write("nan");
+    if (isinf(v)) return write("inf");
+    char buf[48];
+    int n = snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    if (n < 0 || (size_t)n >= sizeof(buf)) return write("ovf");
+    return write((const uint8_t*)buf, (size_t)n);
+}
+
+int Print::printf(const char* format, ...) {
+    char buf[512];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (n < 0) return n;
+    if ((size_t)n >= sizeof(buf)) n = sizeof(buf) - 1;
+    return (int)write((const uint8_t*)buf, (size_t)n);
+}
+
+// ---- HardwareSerial ----
+//
+// TX: a buffer of txCapacity bytes drains one byte per byte time from txNextDoneUs.
+// RX: injected bytes wait on the "wire" and land in the RX buffer one per byte
+// time; a byte that finds the buffer full is an overrun, as on the LPUART.
+// Both are brought up to date lazily from the virtual clock on every access.
+
+HardwareSerial::HardwareSerial(uint8_t index, size_t txBufferSize, size_t rxBufferSize)
+    : index(index), baud(0), txCapacity(txBufferSize), rxCapacity(rxBufferSize),
+      txPending(0), txNextDoneUs(0), rxBuf(nullptr), rxHead(0), rxCount(0),
+      wire(nullptr), wireHead(0), wireCount(0), wireCap(0), rxNextUs(0),
+      rxOverruns(0), txStallUs(0), sink(nullptr) {
+    rxBuf = (uint8_t*)calloc(rxCapacity, 1);
+}
+
+uint64_t HardwareSerial::byteTimeUs() const {
+    // 1 start + 8 data + 1 stop bit; rounded up.
+    return baud > 0 ? (10000000ULL + baud - 1) / baud : 0;
+}
+
+void HardwareSerial::begin(uint32_t baudRate, uint16_t format) {
+    (void)format;
+    baud = baudRate;
+    txPending = 0;
+    rxNextUs = nowUs;
+}
+
+void HardwareSerial::end() {
+    nativeService(nowUs);
+    baud = 0;
+}
+
+void HardwareSerial::nativeService(uint64_t now) {
+    uint64_t bt = byteTimeUs();
+    if (bt == 0) {
+        txPending = 0;
+        return;
+    }
+    if (txPending > 0 && txNextDoneUs <= now) {
+        uint64_t done = (now - txNextDoneUs) / bt + 1;
+        if (done >= txPending) {
+            txPending = 0;
+        } else {
+            txPending -= (size_t)done;
+            txNextDoneUs += done * bt;
+        }
+    }
+    while (wireCount > 0 && rxNextUs <= now) {
+        uint8_t c = wire[wireHead];
+        wireHead = (wireHead + 1) % wireCap;
+        wireCount--;
+        if (rxCount < rxCapacity) {
+            rxBuf[(rxHead + rxCount) % rxCapacity] = c;
+            rxCount++;
+        } else {
+            rxOverruns++;
+        }
+        rxNextUs += bt;
+    }
+}
+
+int HardwareSerial::available() {
+    nativeService(nowUs);
+    return (int)rxCount;
+}
+
+int HardwareSerial::peek() {
+    nativeService(nowUs);
+    return rxCount > 0 ? rxBuf[rxHead] : -1;
+}
+
+int HardwareSerial::read() {
+    nativeService(nowUs);
+    if (rxCount == 0) return -1;
+    uint8_t c = rxBuf[rxHead];
+    rxHead = (rxHead + 1) % rxCapacity;
+    rxCount--;
+    return c;
+}
+
+int HardwareSerial::availableForWrite() {
+    nativeService(nowUs);
+    // One slot of the ring always stays empty in the Teensy core.
+    return txPending + 1 >= txCapacity ? 0 : (int)(txCapacity - 1 - txPending);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    nativeService(nowUs);
+    if (byteTimeUs() > 0) {
+        // Buffer full: the core spins until the ISR frees a slot.
+        while (txPending + 1 >= txCapacity) {
+            uint64_t waitUs = txNextDoneUs > nowUs ? txNextDoneUs - nowUs : 0;
+            txStallUs += waitUs;
+            nativeAdvanceMicros(waitUs);
+            nativeService(nowUs);
+        }
+        if (txPending == 0) txNextDoneUs = nowUs + byteTimeUs();
+        txPending++;
+    }
+    if (sink != nullptr) fputc(c, sink);
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t len) {
+    for (size_t i = 0; i < len; i++) write(buf[i]);
+    return len;
+}
+
+void HardwareSerial::flush() {
+    nativeService(nowUs);
+    if (txPending > 0) {
+        uint64_t endUs = txNextDoneUs + (txPending - 1) * byteTimeUs();
+        nativeAdvanceMicros(endUs - nowUs);
+        nativeService(nowUs);
+    }
+    if (sink != nullptr) fflush(sink);
+}
+
+void HardwareSerial::addMemoryForWrite(void* buffer, size_t size) {
+    if (buffer != nullptr) txCapacity += size;
+}
+
+void HardwareSerial::growRx(size_t extra) {
+    // Unroll the ring into a larger one.
+    uint8_t* grown = (uint8_t*)calloc(rxCapacity + extra, 1);
+    for (size_t i = 0; i < rxCount; i++) grown[i] = rxBuf[(rxHead + i) % rxCapacity];
+    free(rxBuf);
+    rxBuf = grown;
+    rxHead = 0;
+    rxCapacity += extra;
+}
+
+void HardwareSerial::addMemoryForRead(void* buffer, size_t size) {
+    if (buffer != nullptr) growRx(size);
+}
+
+void HardwareSerial::nativeSetSink(FILE* out) {
+    sink = out;
+}
+
+void HardwareSerial::nativeInject(const uint8_t* data, size_t len) {
+    nativeService(nowUs);
+    if (wireCount + len > wireCap) {
+        size_t cap = wireCap > 0 ? wireCap : 256;
+        while (cap < wireCount + len) cap *= 2;
+        uint8_t* grown = (uint8_t*)malloc(cap);
+        for (size_t i = 0; i < wireCount; i++) grown[i] = wire[(wireHead + i) % wireCap];
+        free(wire);
+        wire = grown;
+        wireHead = 0;
+        wireCap = cap;
+    }
+    if (wireCount == 0) {
+        // Line idle: the first byte finishes one byte time from now.
+        uint64_t start = rxNextUs > nowUs ? rxNextUs : nowUs;
+        rxNextUs = start + byteTimeUs();
+    }
+    for (size_t i = 0; i < len; i++) {
+        wire[(wireHead + wireCount) % wireCap] = data[i];
+        wireCount++;
+    }
+}
+
+// ---- USB Serial ----
+
+size_t usb_serial_class::write(uint8_t c) {
+    if (enabled) fputc(c, stdout);
+    return 1;
+}
+
+size_t usb_serial_class::write(const uint8_t* buf, size_t len) {
+    if (enabled) fwrite(buf, 1, len, stdout);
+    return len;
+}
+
+void usb_serial_class::flush() {
+    if (enabled) fflush(stdout);
+}
+
+// Teensy 4.1 core defaults: 40-byte TX and 64-byte RX buffers per LPUART.
+usb_serial_class Serial;
+HardwareSerial Serial1(1, 40, 64);
+HardwareSerial Serial2(2, 40, 64);
+HardwareSerial Serial3(3, 40, 64);
+HardwareSerial Serial4(4, 40, 64);
+HardwareSerial Serial5(5, 40, 64);
+HardwareSerial Serial6(6, 40, 64);
+HardwareSerial Serial7(7, 40, 64);
+HardwareSerial Serial8(8, 40, 64);
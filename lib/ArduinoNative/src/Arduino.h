@@ -0,0 +1,195 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host stand-in for the Teensy 4.1 Arduino core ([env:native] only).
+//
+// Time is virtual: millis()/micros() read a 64-bit microsecond counter that only
+// moves when the runner (NativeMain.cpp) advances it between loop() calls, or when
+// the FSW waits (delay, a blocking UART write). A run is deterministic and as fast
+// as the host executes loop().
+//
+// UARTs model the Teensy buffers at their configured baud rate: TX drains and RX
+// arrives one byte per 10 bit times of virtual time, so availableForWrite() and RX
+// overflow behave as on hardware. USB Serial goes straight to stdout.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+
+// Teensy memory placement attributes: plain RAM on the host.
+#define DMAMEM
+#define FASTRUN
+#define EXTMEM
+#define PROGMEM
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// Virtual clock (native only).
+uint64_t nativeMicros64();
+// Move virtual time forward, firing IntervalTimers and UART activity on the way.
+void nativeAdvanceMicros(uint64_t us);
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len);
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t write(const char* buf, size_t len) { return write((const uint8_t*)buf, len); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int v, int base = DEC) { return printSigned(v, base); }
+    size_t print(unsigned int v, int base = DEC) { return printUnsigned(v, base); }
+    size_t print(long v, int base = DEC) { return printSigned(v, base); }
+    size_t print(unsigned long v, int base = DEC) { return printUnsigned(v, base); }
+    size_t print(long long v, int base = DEC) { return printSigned(v, base); }
+    size_t print(unsigned long long v, int base = DEC) { return printUnsigned(v, base); }
+    size_t print(double v, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(T v) { size_t n = print(v); return n + println(); }
+    template <typename T>
+    size_t println(T v, int format) { size_t n = print(v, format); return n + println(); }
+
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    size_t printSigned(long long v, int base);
+    size_t printUnsigned(unsigned long long v, int base);
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+class HardwareSerial : public Stream {
+public:
+    HardwareSerial(uint8_t index, size_t txBufferSize, size_t rxBufferSize);
+
+    void begin(uint32_t baud, uint16_t format = 0);
+    void end();
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+    int availableForWrite() override;
+    void addMemoryForWrite(void* buffer, size_t size);
+    void addMemoryForRead(void* buffer, size_t size);
+    operator bool() { return true; }
+
+    // Native only: bytes sent by the FSW are copied to sink (nullptr = dropped);
+    // injected bytes arrive on RX at the baud rate after those already queued.
+    void nativeSetSink(FILE* sink);
+    void nativeInject(const uint8_t* data, size_t len);
+    uint32_t nativeRxOverruns() const { return rxOverruns; }
+    uint64_t nativeTxStallUs() const { return txStallUs; }  // Time write() spent blocked
+    uint8_t nativeIndex() const { return index; }
+    void nativeService(uint64_t nowUs);
+
+private:
+    uint8_t index;
+    uint32_t baud;
+    size_t txCapacity;
+    size_t rxCapacity;
+    size_t txPending;
+    uint64_t txNextDoneUs;
+    uint8_t* rxBuf;     // Ring of rxCapacity bytes
+    size_t rxHead, rxCount;
+    uint8_t* wire;      // Injected bytes not yet received (grows as needed)
+    size_t wireHead, wireCount, wireCap;
+    uint64_t rxNextUs;
+    uint32_t rxOverruns;
+    uint64_t txStallUs;
+    FILE* sink;
+
+    uint64_t byteTimeUs() const;
+    void growRx(size_t extra);
+};
+
+// USB serial: output to stdout, never blocks; no input.
+class usb_serial_class : public Stream {
+public:
+    void begin(uint32_t baud) { (void)baud; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+    int availableForWrite() override { return 4096; }
+    void flush() override;
+    operator bool() { return true; }
+
+    void nativeSetEnabled(bool on) { enabled = on; }
+
+private:
+    bool enabled = true;
+};
+
+extern usb_serial_class Serial;
+extern HardwareSerial Serial1, Serial2, Serial3, Serial4, Serial5, Serial6, Serial7, Serial8;
+
+// Periodic callback on virtual time (Teensy has four PIT channels).
+class IntervalTimer {
+public:
+    IntervalTimer() : slot(-1) {}
+    ~IntervalTimer() { end(); }
+    bool begin(void (*callback)(), uint32_t periodUs);
+    bool begin(void (*callback)(), int periodUs) { return begin(callback, (uint32_t)periodUs); }
+    bool begin(void (*callback)(), float periodUs) { return begin(callback, (uint32_t)periodUs); }
+    void update(uint32_t periodUs);
+    void end();
+    void priority(uint8_t level) { (void)level; }
+
+private:
+    int slot;
+};
+
+void setup();
+void loop();
+
+#endif // ARDUINO_H
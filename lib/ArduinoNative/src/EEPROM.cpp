@@ -0,0 +1,43 @@
+// File-backed EEPROM for [env:native] (see EEPROM.h).
+#include "EEPROM.h"
+#include "NativeWorld.h"
+#include <stdio.h>
+
+EEPROMClass EEPROM;
+
+void EEPROMClass::load() {
+    loaded = true;
+    memset(data, 0xFF, sizeof(data));  // Erased flash reads 0xFF
+    char path[320];
+    if (!nativeFsPath("", "eeprom.bin", path, sizeof(path))) return;
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) return;
+    size_t n = fread(data, 1, sizeof(data), f);
+    (void)n;
+    fclose(f);
+}
+
+uint8_t EEPROMClass::read(int address) {
+    if (!loaded) load();
+    if (address < 0 || address >= SIZE) return 0;
+    return data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (!loaded) load();
+    if (address < 0 || address >= SIZE || data[address] == value) return;
+    data[address] = value;
+    // Write-through, so a killed run keeps what the FSW stored (as the flash would).
+    char path[320];
+    if (!nativeFsPath("", "eeprom.bin", path, sizeof(path))) return;
+    FILE* f = fopen(path, "r+b");
+    if (f == nullptr) {
+        f = fopen(path, "wb");
+        if (f == nullptr) return;
+        fwrite(data, 1, sizeof(data), f);
+    } else {
+        fseek(f, address, SEEK_SET);
+        fputc(value, f);
+    }
+    fclose(f);
+}
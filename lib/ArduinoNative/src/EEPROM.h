@@ -0,0 +1,41 @@
+#ifndef EEPROM_H
+#define EEPROM_H
+
+// Teensy 4.1 emulated EEPROM (4284 bytes) for [env:native], kept in
+// <fs root>/eeprom.bin so stored state survives between runs like a reset.
+
+#include <stdint.h>
+#include <string.h>
+
+class EEPROMClass {
+public:
+    static const int SIZE = 4284;
+
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    void update(int address, uint8_t value) { write(address, value); }
+    uint16_t length() { return SIZE; }
+
+    template <typename T>
+    T& get(int address, T& value) {
+        uint8_t* p = (uint8_t*)&value;
+        for (size_t i = 0; i < sizeof(T); i++) p[i] = read(address + (int)i);
+        return value;
+    }
+
+    template <typename T>
+    const T& put(int address, const T& value) {
+        const uint8_t* p = (const uint8_t*)&value;
+        for (size_t i = 0; i < sizeof(T); i++) write(address + (int)i, p[i]);
+        return value;
+    }
+
+private:
+    uint8_t data[SIZE];
+    bool loaded = false;
+    void load();
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // EEPROM_H
@@ -0,0 +1,170 @@
+// Host-file LittleFS for [env:native] (see LittleFS.h).
+#include "LittleFS.h"
+#include "NativeWorld.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const uint64_t FLASH_BLOCK_BYTES = 4096;
+
+File File::openHost(const char* hostPath, const char* name, uint8_t mode) {
+    File f;
+    struct stat st;
+    if (stat(hostPath, &st) == 0 && S_ISDIR(st.st_mode)) {
+        f.dir = opendir(hostPath);
+    } else if (mode == FILE_READ) {
+        f.fd = ::open(hostPath, O_RDONLY);
+    } else {
+        f.fd = ::open(hostPath, O_RDWR | O_CREAT, 0644);
+        if (f.fd >= 0 && mode == FILE_WRITE) lseek(f.fd, 0, SEEK_END);
+    }
+    if (f) {
+        snprintf(f.path, sizeof(f.path), "%s", hostPath);
+        snprintf(f.entryName, sizeof(f.entryName), "%s", name);
+    }
+    return f;
+}
+
+size_t File::write(const void* buf, size_t size) {
+    if (fd < 0) return 0;
+    ssize_t n = ::write(fd, buf, size);
+    return n < 0 ? 0 : (size_t)n;
+}
+
+int File::read(void* buf, size_t nbyte) {
+    if (fd < 0) return -1;
+    return (int)::read(fd, buf, nbyte);
+}
+
+int File::read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+}
+
+int File::available() {
+    uint64_t s = size(), p = position();
+    return p < s ? (int)(s - p) : 0;
+}
+
+bool File::seek(uint64_t pos) {
+    return fd >= 0 && lseek(fd, (off_t)pos, SEEK_SET) == (off_t)pos;
+}
+
+uint64_t File::position() {
+    if (fd < 0) return 0;
+    off_t pos = lseek(fd, 0, SEEK_CUR);
+    return pos < 0 ? 0 : (uint64_t)pos;
+}
+
+uint64_t File::size() {
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) return 0;
+    return (uint64_t)st.st_size;
+}
+
+void File::close() {
+    if (fd >= 0) ::close(fd);
+    if (dir != nullptr) closedir(dir);
+    fd = -1;
+    dir = nullptr;
+}
+
+File File::openNextFile(uint8_t mode) {
+    if (dir == nullptr) return File();
+    struct dirent* e;
+    while ((e = readdir(dir)) != nullptr) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        char hostPath[600];
+        snprintf(hostPath, sizeof(hostPath), "%s/%s", path, e->d_name);
+        return openHost(hostPath, e->d_name, mode);
+    }
+    return File();
+}
+
+void File::rewindDirectory() {
+    if (dir != nullptr) rewinddir(dir);
+}
+
+bool FS::hostPath(const char* path, char* out, size_t size) {
+    return mounted && nativeFsPath("flash", path, out, size);
+}
+
+File FS::open(const char* path, uint8_t mode) {
+    char p[320];
+    if (!hostPath(path, p, sizeof(p))) return File();
+    if (mode != FILE_READ && usedSize() + FLASH_BLOCK_BYTES > capacity) {
+        struct stat st;
+        if (stat(p, &st) != 0) return File();  // No block left for a new file
+    }
+    const char* slash = strrchr(path, '/');
+    return File::openHost(p, slash != nullptr ? slash + 1 : path, mode);
+}
+
+bool FS::exists(const char* path) {
+    char p[320];
+    struct stat st;
+    return hostPath(path, p, sizeof(p)) && stat(p, &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+    char p[320];
+    return hostPath(path, p, sizeof(p)) && unlink(p) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+    char p[320];
+    return hostPath(path, p, sizeof(p)) && ::mkdir(p, 0755) == 0;
+}
+
+uint64_t FS::usedSize() {
+    // Two blocks of superblock/metadata plus each file rounded up to whole blocks.
+    char root[320];
+    if (!hostPath("/", root, sizeof(root))) return 0;
+    uint64_t used = 2 * FLASH_BLOCK_BYTES;
+    DIR* d = opendir(root);
+    if (d == nullptr) return used;
+    struct dirent* e;
+    while ((e = readdir(d)) != nullptr) {
+        if (e->d_name[0] == '.') continue;
+        char p[600];
+        struct stat st;
+        snprintf(p, sizeof(p), "%s/%s", root, e->d_name);
+        if (stat(p, &st) == 0 && S_ISREG(st.st_mode)) {
+            used += ((uint64_t)st.st_size + FLASH_BLOCK_BYTES - 1) / FLASH_BLOCK_BYTES * FLASH_BLOCK_BYTES;
+        }
+    }
+    closedir(d);
+    return used;
+}
+
+bool LittleFS::quickFormat() {
+    char root[320];
+    if (!hostPath("/", root, sizeof(root))) return false;
+    DIR* d = opendir(root);
+    if (d == nullptr) return false;
+    struct dirent* e;
+    while ((e = readdir(d)) != nullptr) {
+        if (e->d_name[0] == '.') continue;
+        char p[600];
+        snprintf(p, sizeof(p), "%s/%s", root, e->d_name);
+        unlink(p);
+    }
+    closedir(d);
+    return true;
+}
+
+bool LittleFS_Program::begin(uint32_t size) {
+    char root[320];
+    mounted = nativeWorld.flashPresent && nativeFsPath("flash", "/", root, sizeof(root));
+    capacity = mounted ? size : 0;
+    return mounted;
+}
+
+bool LittleFS_QSPIFlash::begin() {
+    char root[320];
+    mounted = nativeWorld.flashPresent && nativeFsPath("flash", "/", root, sizeof(root));
+    capacity = mounted ? 16ULL * 1024 * 1024 : 0;
+    return mounted;
+}
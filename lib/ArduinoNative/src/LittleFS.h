@@ -0,0 +1,83 @@
+#ifndef LITTLEFS_H
+#define LITTLEFS_H
+
+// Teensy LittleFS (program and QSPI flash) for [env:native], backed by host files
+// under <fs root>/flash. Space is accounted in 4 KB erase blocks against the size
+// given to begin(), so "flash full" handling runs as on the target; erases are free.
+
+#include <dirent.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FILE_READ 0
+#define FILE_WRITE 1        // Append
+#define FILE_WRITE_BEGIN 2  // Write from the start without truncating
+
+// Handle semantics as in the Teensy FS core: copies share the descriptor.
+class File {
+public:
+    File() : fd(-1), dir(nullptr) { entryName[0] = '\0'; }
+
+    size_t write(const void* buf, size_t size);
+    size_t write(uint8_t b) { return write(&b, 1); }
+    int read(void* buf, size_t nbyte);
+    int read();
+    int available();
+    void flush() {}
+    bool seek(uint64_t pos);
+    uint64_t position();
+    uint64_t size();
+    void close();
+    const char* name() { return entryName; }
+    bool isDirectory() { return dir != nullptr; }
+    File openNextFile(uint8_t mode = FILE_READ);
+    void rewindDirectory();
+    operator bool() const { return fd >= 0 || dir != nullptr; }
+
+private:
+    friend class FS;
+    int fd;
+    DIR* dir;
+    char path[320];
+    char entryName[256];
+
+    static File openHost(const char* hostPath, const char* entryName, uint8_t mode);
+};
+
+class FS {
+public:
+    virtual ~FS() {}
+    File open(const char* path, uint8_t mode = FILE_READ);
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool mkdir(const char* path);
+    uint64_t totalSize() { return capacity; }
+    uint64_t usedSize();
+
+protected:
+    uint64_t capacity = 0;
+    bool mounted = false;
+    bool hostPath(const char* path, char* out, size_t size);
+};
+
+class LittleFS : public FS {
+public:
+    bool formatUnused(size_t blockCount, size_t blockStart) {
+        (void)blockCount;
+        (void)blockStart;
+        return mounted;
+    }
+    bool quickFormat();
+};
+
+class LittleFS_Program : public LittleFS {
+public:
+    bool begin(uint32_t size);
+};
+
+class LittleFS_QSPIFlash : public LittleFS {
+public:
+    bool begin();  // 16 MB chip
+};
+
+#endif // LITTLEFS_H
@@ -0,0 +1,125 @@
+// Host runner for [env:native]: calls the FSW's unmodified setup() and loop() on a
+// virtual clock, feeding the sensor shims from a flight profile and the radio/GPS
+// UARTs from timed scripts.
+//
+//   program [--seconds N] [--tick-us N] [--profile FILE] [--commands FILE]
+//           [--gps FILE] [--xbee-out FILE|-] [--baro-noise M] [--absent LIST]
+//           [--fs-dir DIR] [--quiet]
+//
+// --profile, --commands, --gps: file formats in NativeReplay.h.
+// --tick-us   virtual time charged per loop() pass (default 1000).
+// --absent    comma list of bmp,ina,bno,sd,flash to leave out of the "hardware".
+// State (EEPROM, SD, flash) persists in --fs-dir (default native_fs) across runs,
+// like resets on the bench.
+//
+// Host tests (pio test -e native) bring their own main() and step the FSW with
+// NativeReplay, so this file is left out of test builds.
+#ifndef PIO_UNIT_TESTING
+
+#include <Arduino.h>
+#include "NativeReplay.h"
+#include "NativeWorld.h"
+#include <chrono>
+#include <string>
+
+static bool setAbsent(const char* list) {
+    std::string s(list);
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = s.find(',', start);
+        if (end == std::string::npos) end = s.size();
+        std::string name = s.substr(start, end - start);
+        if (name == "bmp") nativeWorld.bmpPresent = false;
+        else if (name == "ina") nativeWorld.inaPresent = false;
+        else if (name == "bno") nativeWorld.bnoPresent = false;
+        else if (name == "sd") nativeWorld.sdPresent = false;
+        else if (name == "flash") nativeWorld.flashPresent = false;
+        else if (!name.empty()) {
+            fprintf(stderr, "native: unknown device '%s' in --absent\n", name.c_str());
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    double seconds = 120.0;
+    uint32_t tickUs = 1000;
+    FILE* xbeeOut = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char* opt = argv[i];
+        const char* val = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (strcmp(opt, "--quiet") == 0) {
+            Serial.nativeSetEnabled(false);
+            continue;
+        }
+        if (val == nullptr) {
+            fprintf(stderr, "native: %s needs a value\n", opt);
+            return 2;
+        }
+        i++;
+        if (strcmp(opt, "--seconds") == 0) seconds = atof(val);
+        else if (strcmp(opt, "--tick-us") == 0) tickUs = (uint32_t)strtoul(val, nullptr, 10);
+        else if (strcmp(opt, "--profile") == 0) ok = nativeLoadProfile(val);
+        else if (strcmp(opt, "--commands") == 0) ok = nativeLoadCommands(val);
+        else if (strcmp(opt, "--gps") == 0) ok = nativeLoadGps(val);
+        else if (strcmp(opt, "--baro-noise") == 0) nativeWorld.baroNoiseM = (float)atof(val);
+        else if (strcmp(opt, "--absent") == 0) ok = setAbsent(val);
+        else if (strcmp(opt, "--fs-dir") == 0) nativeSetFsRoot(val);
+        else if (strcmp(opt, "--xbee-out") == 0) {
+            xbeeOut = strcmp(val, "-") == 0 ? stdout : fopen(val, "wb");
+            ok = xbeeOut != nullptr;
+        } else {
+            fprintf(stderr, "native: unknown option %s\n", opt);
+            return 2;
+        }
+        if (!ok) return 2;
+    }
+    if (tickUs == 0 || seconds <= 0.0) {
+        fprintf(stderr, "native: --seconds and --tick-us must be positive\n");
+        return 2;
+    }
+    Serial5.nativeSetSink(xbeeOut);
+
+    const uint64_t endUs = (uint64_t)(seconds * 1e6);
+    uint64_t passes = 0;
+    double loopWallTotalUs = 0.0, loopWallMaxUs = 0.0;
+    auto wallStart = std::chrono::steady_clock::now();
+
+    nativeReplayStep(0.0);
+    setup();
+    while (nativeMicros64() < endUs) {
+        nativeReplayStep(nativeMicros64() / 1e6);
+        auto t0 = std::chrono::steady_clock::now();
+        nativeLoopPass(tickUs);
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        loopWallTotalUs += us;
+        if (us > loopWallMaxUs) loopWallMaxUs = us;
+        passes++;
+    }
+    Serial.flush();
+    if (xbeeOut != nullptr) fflush(xbeeOut);
+
+    double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double simS = nativeMicros64() / 1e6;
+    fprintf(stderr, "native: %.3f s simulated in %.3f s wall (%.1fx), %llu loop() passes, "
+                    "mean %.2f us, max %.1f us\n",
+            simS, wallS, wallS > 0.0 ? simS / wallS : 0.0, (unsigned long long)passes,
+            passes > 0 ? loopWallTotalUs / passes : 0.0, loopWallMaxUs);
+    HardwareSerial* ports[] = { &Serial1, &Serial2, &Serial3, &Serial4,
+                                &Serial5, &Serial6, &Serial7, &Serial8 };
+    for (HardwareSerial* p : ports) {
+        if (p->nativeTxStallUs() > 0 || p->nativeRxOverruns() > 0) {
+            fprintf(stderr, "native: Serial%u blocked %llu us in write(), %lu RX overruns\n",
+                    p->nativeIndex(), (unsigned long long)p->nativeTxStallUs(),
+                    (unsigned long)p->nativeRxOverruns());
+        }
+    }
+    if (xbeeOut != nullptr && xbeeOut != stdout) fclose(xbeeOut);
+    return 0;
+}
+
+#endif // PIO_UNIT_TESTING
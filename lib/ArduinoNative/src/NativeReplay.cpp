@@ -0,0 +1,127 @@
+// Profile and script replay for [env:native] (see NativeReplay.h).
+#include "NativeReplay.h"
+#include "NativeWorld.h"
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+struct ProfilePoint {
+    double t;
+    float alt;
+    float accel[3];
+};
+
+struct ScriptLine {
+    double t;
+    std::string text;
+};
+
+static std::vector<ProfilePoint> profile;
+static std::vector<ScriptLine> commandScript;
+static std::vector<ScriptLine> gpsScript;
+static size_t nextCommand = 0;
+static size_t nextGps = 0;
+
+static bool readLines(const char* path, std::vector<std::string>& out) {
+    FILE* f = fopen(path, "r");
+    if (f == nullptr) {
+        fprintf(stderr, "native: cannot open %s\n", path);
+        return false;
+    }
+    char line[1024];
+    while (fgets(line, sizeof(line), f) != nullptr) {
+        size_t n = strlen(line);
+        while (n > 0 && (line[n - 1] == '\n' || line[n - 1] == '\r')) line[--n] = '\0';
+        const char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0' || *p == '#') continue;
+        out.push_back(p);
+    }
+    fclose(f);
+    return true;
+}
+
+bool nativeLoadProfile(const char* path) {
+    std::vector<std::string> lines;
+    if (!readLines(path, lines)) return false;
+    for (const std::string& l : lines) {
+        ProfilePoint pt = {};
+        int n = sscanf(l.c_str(), "%lf %f %f %f %f", &pt.t, &pt.alt, &pt.accel[0], &pt.accel[1], &pt.accel[2]);
+        if (n < 2 || (!profile.empty() && pt.t < profile.back().t)) {
+            fprintf(stderr, "native: bad profile line: %s\n", l.c_str());
+            return false;
+        }
+        profile.push_back(pt);
+    }
+    return true;
+}
+
+static bool loadScript(const char* path, std::vector<ScriptLine>& out) {
+    std::vector<std::string> lines;
+    if (!readLines(path, lines)) return false;
+    for (const std::string& l : lines) {
+        char* end = nullptr;
+        double t = strtod(l.c_str(), &end);
+        if (end == l.c_str()) {
+            fprintf(stderr, "native: bad script line: %s\n", l.c_str());
+            return false;
+        }
+        while (*end == ' ' || *end == '\t') end++;
+        out.push_back({ t, std::string(end) + "\r\n" });
+    }
+    return true;
+}
+
+bool nativeLoadCommands(const char* path) {
+    return loadScript(path, commandScript);
+}
+
+bool nativeLoadGps(const char* path) {
+    return loadScript(path, gpsScript);
+}
+
+void nativeReplayReset() {
+    profile.clear();
+    commandScript.clear();
+    gpsScript.clear();
+    nextCommand = 0;
+    nextGps = 0;
+}
+
+static void updateWorld(double t) {
+    if (profile.empty()) return;
+    size_t i = 0;
+    while (i + 1 < profile.size() && profile[i + 1].t <= t) i++;
+    const ProfilePoint& a = profile[i];
+    if (i + 1 >= profile.size() || t <= a.t) {
+        nativeWorld.altitudeM = a.alt;
+        memcpy(nativeWorld.linearAccel, a.accel, sizeof(a.accel));
+        return;
+    }
+    const ProfilePoint& b = profile[i + 1];
+    float f = (float)((t - a.t) / (b.t - a.t));
+    nativeWorld.altitudeM = a.alt + (b.alt - a.alt) * f;
+    for (int k = 0; k < 3; k++) {
+        nativeWorld.linearAccel[k] = a.accel[k] + (b.accel[k] - a.accel[k]) * f;
+    }
+}
+
+static void injectDue(double t, std::vector<ScriptLine>& script, size_t& next, HardwareSerial& port) {
+    while (next < script.size() && script[next].t <= t) {
+        const std::string& s = script[next].text;
+        port.nativeInject((const uint8_t*)s.data(), s.size());
+        next++;
+    }
+}
+
+void nativeReplayStep(double t) {
+    updateWorld(t);
+    injectDue(t, commandScript, nextCommand, Serial5);
+    injectDue(t, gpsScript, nextGps, Serial1);
+}
+
+void nativeLoopPass(uint32_t tickUs) {
+    loop();
+    yield();  // As the Teensy core's main() does between passes
+    nativeAdvanceMicros(tickUs);
+}
@@ -0,0 +1,29 @@
+#ifndef NATIVEREPLAY_H
+#define NATIVEREPLAY_H
+
+#include <stdint.h>
+
+// Flight replay for [env:native]: a profile drives NativeWorld and timed scripts
+// feed the radio (Serial5) and GPS (Serial1) UARTs. Used by the runner
+// (NativeMain.cpp) and by host tests that step setup()/loop() themselves.
+//
+// File formats ('#' lines and blank lines are ignored):
+//   profile   "t_s altitude_m [ax ay az]" (linear acceleration, m/s²), linearly
+//             interpolated; the last line holds after its time.
+//   commands  "t_s text": text + CRLF is sent on Serial5 at t_s.
+//   gps       "t_s NMEA": the sentence + CRLF is sent on Serial1 at t_s.
+
+bool nativeLoadProfile(const char* path);
+bool nativeLoadCommands(const char* path);
+bool nativeLoadGps(const char* path);
+
+// Drop everything loaded and rewind the scripts.
+void nativeReplayReset();
+
+// Bring NativeWorld to time t_s and send every script line due by then.
+void nativeReplayStep(double t);
+
+// One pass of the Teensy core's main(): loop(), yield(), then tickUs of virtual time.
+void nativeLoopPass(uint32_t tickUs);
+
+#endif // NATIVEREPLAY_H
@@ -0,0 +1,94 @@
+// Adafruit sensor and I2C shims for [env:native], fed from NativeWorld.
+#include <Adafruit_BMP3XX.h>
+#include <Adafruit_BNO055.h>
+#include <Adafruit_INA219.h>
+#include <Arduino.h>
+#include <Wire.h>
+#include <math.h>
+#include <string.h>
+#include "NativeWorld.h"
+
+TwoWire Wire;
+
+// ---- BMP390 ----
+
+bool Adafruit_BMP3XX::begin_I2C(uint8_t address, TwoWire* wire) {
+    (void)address;
+    (void)wire;
+    return nativeWorld.bmpPresent;
+}
+
+bool Adafruit_BMP3XX::performReading() {
+    if (!nativeWorld.bmpPresent) return false;
+    double alt = nativeWorld.altitudeM;
+    if (nativeWorld.baroNoiseM > 0.0f) alt += nativeWorld.baroNoiseM * nativeGaussian();
+    // Inverse of altitude = 44330 * (1 - (P/P0)^0.1903)
+    pressure = 101325.0 * pow(1.0 - alt / 44330.0, 1.0 / 0.1903);
+    temperature = nativeWorld.temperatureC;
+    return true;
+}
+
+// ---- INA219 ----
+
+bool Adafruit_INA219::begin(TwoWire* wire) {
+    (void)wire;
+    return nativeWorld.inaPresent;
+}
+
+float Adafruit_INA219::getBusVoltage_V() {
+    return nativeWorld.inaPresent ? nativeWorld.busVoltageV : NAN;
+}
+
+float Adafruit_INA219::getShuntVoltage_mV() {
+    return nativeWorld.inaPresent ? nativeWorld.currentmA * 0.1f : NAN;  // 0.1 ohm shunt
+}
+
+float Adafruit_INA219::getCurrent_mA() {
+    return nativeWorld.inaPresent ? nativeWorld.currentmA : NAN;
+}
+
+float Adafruit_INA219::getPower_mW() {
+    return nativeWorld.inaPresent ? nativeWorld.busVoltageV * nativeWorld.currentmA : NAN;
+}
+
+// ---- BNO055 ----
+
+Adafruit_BNO055::Adafruit_BNO055(int32_t sensorID, uint8_t address, TwoWire* wire)
+    : sensorID(sensorID) {
+    (void)address;
+    (void)wire;
+}
+
+bool Adafruit_BNO055::begin(adafruit_bno055_opmode_t mode) {
+    (void)mode;
+    return nativeWorld.bnoPresent;
+}
+
+bool Adafruit_BNO055::getEvent(sensors_event_t* event, adafruit_vector_type_t type) {
+    memset(event, 0, sizeof(*event));
+    event->version = sizeof(sensors_event_t);
+    event->sensor_id = sensorID;
+    event->timestamp = (int32_t)millis();
+    const NativeWorld& w = nativeWorld;
+    switch (type) {
+    case VECTOR_LINEARACCEL:
+        memcpy(event->acceleration.v, w.linearAccel, sizeof(event->acceleration.v));
+        break;
+    case VECTOR_ACCELEROMETER:
+        memcpy(event->acceleration.v, w.linearAccel, sizeof(event->acceleration.v));
+        event->acceleration.z += 9.80665f;
+        break;
+    case VECTOR_GRAVITY:
+        event->acceleration.z = 9.80665f;
+        break;
+    case VECTOR_GYROSCOPE:
+        memcpy(event->gyro.v, w.gyroRadS, sizeof(event->gyro.v));
+        break;
+    case VECTOR_EULER:
+        event->orientation.x = w.headingDeg;
+        break;
+    default:
+        break;
+    }
+    return w.bnoPresent;
+}
@@ -0,0 +1,56 @@
+// Simulated environment state and file-system root for [env:native] (see NativeWorld.h).
+#include "NativeWorld.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <filesystem>
+
+NativeWorld nativeWorld = {
+    0.0f, 0.0f, 20.0f,
+    { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, 0.0f,
+    4.0f, 150.0f,
+    true, true, true, true, true,
+};
+
+static char fsRoot[256] = "native_fs";
+
+void nativeSetFsRoot(const char* dir) {
+    if (dir == nullptr || dir[0] == '\0') return;
+    strncpy(fsRoot, dir, sizeof(fsRoot) - 1);
+    fsRoot[sizeof(fsRoot) - 1] = '\0';
+}
+
+void nativeClearFs() {
+    std::error_code ec;
+    std::filesystem::remove_all(fsRoot, ec);
+}
+
+bool nativeFsPath(const char* sub, const char* name, char* out, size_t outSize) {
+    char dir[320];
+    if (sub[0] != '\0') {
+        snprintf(dir, sizeof(dir), "%s/%s", fsRoot, sub);
+    } else {
+        snprintf(dir, sizeof(dir), "%s", fsRoot);
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);  // The root may be nested (test runs)
+    while (*name == '/') name++;  // Device paths are absolute; keep them under the root
+    int n = snprintf(out, outSize, "%s/%s", dir, name);
+    if (n > 0 && out[n - 1] == '/') out[--n] = '\0';
+    return n > 0 && (size_t)n < outSize;
+}
+
+float nativeGaussian() {
+    // xorshift64* + Box-Muller; fixed seed so a run is reproducible.
+    static uint64_t state = 0x9E3779B97F4A7C15ULL;
+    auto next = []() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return (state * 2685821657736338717ULL >> 11) * (1.0 / 9007199254740992.0);
+    };
+    double u1 = next();
+    double u2 = next();
+    if (u1 < 1e-300) u1 = 1e-300;
+    return (float)(sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2));
+}
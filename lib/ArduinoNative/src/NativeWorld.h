@@ -0,0 +1,40 @@
+#ifndef NATIVEWORLD_H
+#define NATIVEWORLD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Truth the sensor shims report ([env:native] only). NativeReplay.cpp updates it
+// from the flight profile before every loop() pass; the Adafruit shims read it
+// when the FSW samples, so the FSW sees the same values a real sensor would.
+
+struct NativeWorld {
+    float altitudeM;         // Barometric altitude (101325 Pa reference)
+    float baroNoiseM;        // 1-sigma noise added per BMP390 reading
+    float temperatureC;
+    float linearAccel[3];    // m/s², gravity removed (BNO055 VECTOR_LINEARACCEL)
+    float gyroRadS[3];
+    float headingDeg;
+    float busVoltageV;
+    float currentmA;
+    bool bmpPresent;
+    bool inaPresent;
+    bool bnoPresent;
+    bool sdPresent;
+    bool flashPresent;
+};
+
+extern NativeWorld nativeWorld;
+
+// Directory the EEPROM image, SD card and flash file systems live under.
+void nativeSetFsRoot(const char* dir);
+// Delete everything under the root: a blank board (fresh EEPROM, empty cards).
+void nativeClearFs();
+// <root>/<sub>/<name> into out ("/" = <root>/<sub>; sub "" = the root itself),
+// creating the directories.
+bool nativeFsPath(const char* sub, const char* name, char* out, size_t outSize);
+
+// Standard normal sample from a fixed-seed generator (repeatable runs).
+float nativeGaussian();
+
+#endif // NATIVEWORLD_H
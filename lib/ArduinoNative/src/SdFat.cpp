@@ -0,0 +1,134 @@
+// Host-file SD card for [env:native] (see SdFat.h).
+#include "SdFat.h"
+#include "NativeWorld.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static bool sdPath(const char* path, char* out, size_t size) {
+    return nativeFsPath("sd", path, out, size);
+}
+
+bool FsFile::openHostPath(const char* hostPath, const char* entryName, int oflag) {
+    close();
+    struct stat st;
+    if (stat(hostPath, &st) == 0 && S_ISDIR(st.st_mode)) {
+        dir = opendir(hostPath);
+    } else {
+        fd = ::open(hostPath, oflag, 0644);
+    }
+    if (!isOpen()) return false;
+    snprintf(path, sizeof(path), "%s", hostPath);
+    snprintf(name, sizeof(name), "%s", entryName);
+    return true;
+}
+
+bool FsFile::open(const char* devicePath, int oflag) {
+    char hostPath[320];
+    if (!sdPath(devicePath, hostPath, sizeof(hostPath))) return false;
+    const char* slash = strrchr(devicePath, '/');
+    return openHostPath(hostPath, slash != nullptr ? slash + 1 : devicePath, oflag);
+}
+
+bool FsFile::openNext(FsFile* dirFile, int oflag) {
+    if (dirFile == nullptr || dirFile->dir == nullptr) return false;
+    struct dirent* e;
+    while ((e = readdir(dirFile->dir)) != nullptr) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        char hostPath[600];
+        snprintf(hostPath, sizeof(hostPath), "%s/%s", dirFile->path, e->d_name);
+        return openHostPath(hostPath, e->d_name, oflag);
+    }
+    return false;
+}
+
+bool FsFile::close() {
+    bool was = isOpen();
+    if (fd >= 0) ::close(fd);
+    if (dir != nullptr) closedir(dir);
+    fd = -1;
+    dir = nullptr;
+    return was;
+}
+
+size_t FsFile::getName(char* out, size_t size) {
+    if (!isOpen() || size == 0) return 0;
+    snprintf(out, size, "%s", name);
+    return strlen(out);
+}
+
+bool FsFile::preAllocate(uint64_t length) {
+    // The host allocates on write; only the bookkeeping check matters here.
+    return fd >= 0 && length > 0;
+}
+
+size_t FsFile::write(const void* buf, size_t count) {
+    if (fd < 0) return 0;
+    ssize_t n = ::write(fd, buf, count);
+    return n < 0 ? 0 : (size_t)n;
+}
+
+int FsFile::read(void* buf, size_t count) {
+    if (fd < 0) return -1;
+    return (int)::read(fd, buf, count);
+}
+
+int FsFile::read() {
+    uint8_t b;
+    return read(&b, 1) == 1 ? b : -1;
+}
+
+bool FsFile::seekSet(uint64_t position) {
+    return fd >= 0 && lseek(fd, (off_t)position, SEEK_SET) == (off_t)position;
+}
+
+uint64_t FsFile::curPosition() const {
+    if (fd < 0) return 0;
+    off_t pos = lseek(fd, 0, SEEK_CUR);
+    return pos < 0 ? 0 : (uint64_t)pos;
+}
+
+uint64_t FsFile::fileSize() const {
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) return 0;
+    return (uint64_t)st.st_size;
+}
+
+bool FsFile::truncate(uint64_t length) {
+    return fd >= 0 && ftruncate(fd, (off_t)length) == 0;
+}
+
+bool FsFile::rewindDirectory() {
+    if (dir == nullptr) return false;
+    rewinddir(dir);
+    return true;
+}
+
+bool SdFs::begin(SdioConfig config) {
+    (void)config;
+    char hostPath[320];
+    return nativeWorld.sdPresent && sdPath("/", hostPath, sizeof(hostPath));
+}
+
+FsFile SdFs::open(const char* path, int oflag) {
+    FsFile f;
+    if (nativeWorld.sdPresent) f.open(path, oflag);
+    return f;
+}
+
+bool SdFs::exists(const char* path) {
+    char hostPath[320];
+    struct stat st;
+    return sdPath(path, hostPath, sizeof(hostPath)) && stat(hostPath, &st) == 0;
+}
+
+bool SdFs::remove(const char* path) {
+    char hostPath[320];
+    return sdPath(path, hostPath, sizeof(hostPath)) && unlink(hostPath) == 0;
+}
+
+bool SdFs::mkdir(const char* path) {
+    char hostPath[320];
+    return sdPath(path, hostPath, sizeof(hostPath)) && ::mkdir(hostPath, 0755) == 0;
+}
@@ -0,0 +1,88 @@
+#ifndef SDFAT_H
+#define SDFAT_H
+
+// SdFat (SdFs/FsFile) for [env:native], backed by host files under
+// <fs root>/sd. Open flags are the POSIX ones, as in SdFat on hosted targets.
+// The card is never busy and sync() does not force the host disk.
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef O_READ
+#define O_READ O_RDONLY
+#endif
+#ifndef O_WRITE
+#define O_WRITE O_WRONLY
+#endif
+
+#define FIFO_SDIO 0
+#define DMA_SDIO 1
+
+class SdioConfig {
+public:
+    explicit SdioConfig(uint8_t options = FIFO_SDIO) : opt(options) {}
+    uint8_t options() const { return opt; }
+
+private:
+    uint8_t opt;
+};
+
+class SdCard {
+public:
+    bool isBusy() { return false; }
+};
+
+// Handle semantics as in SdFat: copies share the descriptor; close() explicitly.
+class FsFile {
+public:
+    FsFile() : fd(-1), dir(nullptr) { name[0] = '\0'; }
+
+    bool open(const char* path, int oflag = O_RDONLY);
+    bool openNext(FsFile* dirFile, int oflag = O_RDONLY);
+    bool close();
+    bool isOpen() const { return fd >= 0 || dir != nullptr; }
+    operator bool() const { return isOpen(); }
+    bool isDir() const { return dir != nullptr; }
+    bool isContiguous() const { return true; }
+    size_t getName(char* out, size_t size);
+
+    bool preAllocate(uint64_t length);
+    size_t write(const void* buf, size_t count);
+    size_t write(uint8_t b) { return write(&b, 1); }
+    int read(void* buf, size_t count);
+    int read();
+    bool seekSet(uint64_t position);
+    uint64_t curPosition() const;
+    uint64_t fileSize() const;
+    bool truncate(uint64_t length);
+    bool truncate() { return truncate(curPosition()); }
+    bool sync() { return isOpen(); }
+    void rewind() { seekSet(0); }
+    bool rewindDirectory();
+
+private:
+    friend class SdFs;
+    int fd;
+    DIR* dir;
+    char path[320];
+    char name[256];
+
+    bool openHostPath(const char* hostPath, const char* entryName, int oflag);
+};
+
+class SdFs {
+public:
+    bool begin(SdioConfig config);
+    FsFile open(const char* path, int oflag = O_RDONLY);
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool mkdir(const char* path);
+    SdCard* card() { return &sdCard; }
+
+private:
+    SdCard sdCard;
+};
+
+#endif // SDFAT_H
@@ -0,0 +1,17 @@
+#ifndef WIRE_H
+#define WIRE_H
+
+// I2C bus for [env:native]: the sensor shims never touch it.
+
+#include <stdint.h>
+
+class TwoWire {
+public:
+    void begin() {}
+    void end() {}
+    void setClock(uint32_t frequency) { (void)frequency; }
+};
+
+extern TwoWire Wire;
+
+#endif // WIRE_H
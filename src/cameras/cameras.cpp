@@ -1,4 +1,5 @@
 #include "cameras.h"
+#include "EventJournal.h"
 #include <Arduino.h>
 
 // Two ESP32-CAM modules with OV2640, controlled over UART.
@@ -28,23 +29,27 @@ void startCamera1Recording() {
     if (!camerasInitialized || camera1Recording) return;
     CAM1_SERIAL.print("START\n");
     camera1Recording = true;
+    journalEvent(EVT_CAMERA, 1, 1);
 }
 
 void stopCamera1Recording() {
     if (!camerasInitialized || !camera1Recording) return;
     CAM1_SERIAL.print("STOP\n");
     camera1Recording = false;
+    journalEvent(EVT_CAMERA, 1, 0);
 }
 
 void startCamera2Recording() {
     if (!camerasInitialized || camera2Recording) return;
     CAM2_SERIAL.print("START\n");
     camera2Recording = true;
+    journalEvent(EVT_CAMERA, 2, 1);
 }
 
 void stopCamera2Recording() {
     if (!camerasInitialized || !camera2Recording) return;
     CAM2_SERIAL.print("STOP\n");
     camera2Recording = false;
+    journalEvent(EVT_CAMERA, 2, 0);
 }
 
@@ -0,0 +1,136 @@
+// Time-tagged command queue (see CommandScheduler.h).
+#include "CommandScheduler.h"
+#include "Commands.h"
+#include "LinkScheduler.h"
+#include "Timing.h"
+#include <Arduino.h>
+#include <string.h>
+
+static ScheduledCommand heap[AT_MAX_PENDING];
+static uint8_t heapSize = 0;
+static uint16_t nextId = 1;
+static CommandSchedulerStats stats;
+
+static bool dueBefore(const ScheduledCommand& a, const ScheduledCommand& b) {
+    return a.dueUs < b.dueUs;
+}
+
+static void swapEntries(uint8_t i, uint8_t j) {
+    ScheduledCommand t = heap[i];
+    heap[i] = heap[j];
+    heap[j] = t;
+}
+
+static void siftUp(uint8_t i) {
+    while (i > 0) {
+        uint8_t parent = (uint8_t)((i - 1) / 2);
+        if (!dueBefore(heap[i], heap[parent])) break;
+        swapEntries(i, parent);
+        i = parent;
+    }
+}
+
+static void siftDown(uint8_t i) {
+    for (;;) {
+        uint8_t left = (uint8_t)(2 * i + 1);
+        uint8_t right = (uint8_t)(left + 1);
+        uint8_t smallest = i;
+        if (left < heapSize && dueBefore(heap[left], heap[smallest])) smallest = left;
+        if (right < heapSize && dueBefore(heap[right], heap[smallest])) smallest = right;
+        if (smallest == i) break;
+        swapEntries(i, smallest);
+        i = smallest;
+    }
+}
+
+static void removeAt(uint8_t i) {
+    heapSize--;
+    if (i == heapSize) return;
+    heap[i] = heap[heapSize];
+    siftDown(i);
+    siftUp(i);
+}
+
+void initCommandScheduler() {
+    heapSize = 0;
+    nextId = 1;
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool scheduleCommand(uint32_t missionMs, const char* line, uint16_t* id) {
+    uint32_t nowMission;
+    if (line == nullptr || heapSize >= AT_MAX_PENDING || strlen(line) >= AT_MAX_LINE ||
+        !getMissionTimeMs(nowMission)) {
+        return false;
+    }
+    // Time of day -> delay from now, wrapping past midnight.
+    uint32_t delay = (missionMs + 86400000UL - nowMission) % 86400000UL;
+    if (delay > AT_MAX_AHEAD_MS) {
+        return false;  // Already passed
+    }
+
+    ScheduledCommand& e = heap[heapSize];
+    e.dueUs = getMonotonicUs() + (uint64_t)delay * 1000;
+    e.missionMs = missionMs;
+    e.id = nextId++;
+    if (nextId == 0) nextId = 1;
+    strcpy(e.line, line);
+    siftUp(heapSize++);
+    if (id != nullptr) *id = e.id;
+    return true;
+}
+
+bool cancelScheduledCommand(uint16_t id) {
+    for (uint8_t i = 0; i < heapSize; i++) {
+        if (heap[i].id == id) {
+            removeAt(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t listScheduledCommands(ScheduledCommand* out, uint8_t max) {
+    if (out == nullptr) return 0;
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < heapSize && n < max; i++) {
+        // Insertion sort by due time; the queue holds a handful of entries.
+        uint8_t j = n++;
+        while (j > 0 && dueBefore(heap[i], out[j - 1])) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        out[j] = heap[i];
+    }
+    return n;
+}
+
+void getCommandSchedulerStats(CommandSchedulerStats* out) {
+    if (out != nullptr) *out = stats;
+}
+
+void updateCommandScheduler() {
+    while (heapSize > 0) {
+        uint64_t now = getMonotonicUs();
+        if (now < heap[0].dueUs) break;
+        ScheduledCommand e = heap[0];
+        removeAt(0);
+
+        uint32_t lateUs = (uint32_t)(now - e.dueUs);
+        bool ok = parseCommand(e.line);
+        stats.executed++;
+        stats.lastLateUs = lateUs;
+        if (lateUs > stats.maxLateUs) stats.maxLateUs = lateUs;
+
+        // Report the command token only: "CMD,<id>,<TOKEN>,..." -> "<TOKEN>,..."
+        const char* cmd = e.line;
+        for (uint8_t commas = 0; commas < 2 && *cmd != '\0'; ++cmd) {
+            if (*cmd == ',') commas++;
+        }
+        char reply[AT_MAX_LINE + 40];
+        snprintf(reply, sizeof(reply), "[AT] RUN %u %lu %s %s\r\n", (unsigned)e.id,
+                 (unsigned long)lateUs, ok ? "OK" : "REJ", cmd);
+        linkSubmit(LINK_ACK, (const uint8_t*)reply, strlen(reply));
+        Serial.print(reply);
+    }
+}
@@ -1,7 +1,18 @@
 #include "Commands.h"
+#include "CommandScheduler.h"
+#include "EventJournal.h"
 #include "telemetry.h"
+#include "TelemetryAggregate.h"
+#include "BinaryTelemetry.h"
+#include "BurstTelemetry.h"
+#include "FlightLog.h"
+#include "BlackBox.h"
+#include "LogDownlink.h"
+#include "Params.h"
+#include "LinkScheduler.h"
 #include "Timing.h"
 #include "Sensors.h"
+#include "StateLogic.h"
 #include "servos.h"
 #include "XBee.h"
 #include <Arduino.h>
@@ -10,6 +21,7 @@
 #include <EEPROM.h>
 
 static uint16_t teamID = 0;
+static CommandLatencyStats latencyStats;
 static bool simulationEnabled = false;
 static bool simulationActive = false;
 
@@ -18,8 +30,16 @@ static bool simulationActive = false;
 const int EEPROM_SIM_ENABLED_ADDR = 50;
 const int EEPROM_SIM_ACTIVE_ADDR  = 51;
 
+// Multi-value command replies go out as their own bracket-prefixed ASCII line
+// (like [GPS_RAW]) at ACK priority, and are mirrored to USB Serial.
+static void sendCommandReply(const char* line) {
+    linkSubmit(LINK_ACK, (const uint8_t*)line, strlen(line));
+    Serial.print(line);
+}
+
 void initCommands() {
-    // Command buffer and line assembly are in XBee (xbeeReceive returns one line per call).
+    // Line assembly and queueing are in XBee (serialEvent5 queues complete lines;
+    // processCommands() drains the queue each tick).
     // Parser state is stateless: parseCommand() handles each line.
     // Team ID is set by main via setTeamID(). Do not clear it here; setup currently
     // calls setTeamID() before initCommands().
@@ -54,23 +74,43 @@ uint16_t getTeamID() {
     return teamID;
 }
 
+// ---- Parameter keywords ----
+// Handlers look their keyword parameters up in small tables instead of strcmp chains.
+
+struct CommandKeyword {
+    const char* word;
+    uint8_t value;
+};
+
+// Index of word in table, or -1.
+static int lookupKeyword(const char* word, const CommandKeyword* table, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(word, table[i].word) == 0) return table[i].value;
+    }
+    return -1;
+}
+
+static const CommandKeyword ON_OFF_WORDS[] = { { "OFF", 0 }, { "ON", 1 } };
+
+// ON -> true, OFF -> false; anything else is not an on/off word.
+static bool parseOnOff(const char* word, bool* on) {
+    if (word == nullptr) return false;
+    int v = lookupKeyword(word, ON_OFF_WORDS, sizeof(ON_OFF_WORDS) / sizeof(ON_OFF_WORDS[0]));
+    if (v < 0) return false;
+    *on = (v == 1);
+    return true;
+}
+
 bool processCXCommand(const char* onOff) {
     // CX - Telemetry On/Off: CMD,<TEAM_ID>,CX,<ON_OFF>
-    if (onOff == nullptr) {
+    bool on;
+    if (!parseOnOff(onOff, &on)) {
         return false;
     }
-    
-    if (strcmp(onOff, "ON") == 0) {
-        setTelemetryEnabled(true);
-        setCommandEcho("CXON");
-        return true;
-    } else if (strcmp(onOff, "OFF") == 0) {
-        setTelemetryEnabled(false);
-        setCommandEcho("CXOFF");
-        return true;
-    }
-    
-    return false;
+
+    setTelemetryEnabled(on);
+    setCommandEcho(on ? "CXON" : "CXOFF");
+    return true;
 }
 
 bool processSTCommand(const char* timeStr) {
@@ -89,39 +129,45 @@ bool processSTCommand(const char* timeStr) {
     return false;
 }
 
+enum SimAction { SIM_ENABLE, SIM_ACTIVATE, SIM_DISABLE };
+static const CommandKeyword SIM_ACTIONS[] = {
+    { "ENABLE", SIM_ENABLE }, { "ACTIVATE", SIM_ACTIVATE }, { "DISABLE", SIM_DISABLE }
+};
+
 bool processSIMCommand(const char* action) {
     // SIM - Simulation Mode: CMD,<TEAM_ID>,SIM,ENABLE|ACTIVATE|DISABLE
     if (action == nullptr) {
         return false;
     }
     
-    if (strcmp(action, "ENABLE") == 0) {
-        simulationEnabled = true;
-        EEPROM.write(EEPROM_SIM_ENABLED_ADDR, 1);
-        setCommandEcho("SIMENABLE");
-        return true;
-    } else if (strcmp(action, "ACTIVATE") == 0) {
-        if (simulationEnabled) {
-            simulationActive = true;
-            setSimulationMode(true);
-            setTelemetryMode(MODE_SIMULATION);
-            EEPROM.write(EEPROM_SIM_ACTIVE_ADDR, 1);
-            setCommandEcho("SIMACTIVATE");
+    switch (lookupKeyword(action, SIM_ACTIONS, sizeof(SIM_ACTIONS) / sizeof(SIM_ACTIONS[0]))) {
+        case SIM_ENABLE:
+            simulationEnabled = true;
+            EEPROM.write(EEPROM_SIM_ENABLED_ADDR, 1);
+            setCommandEcho("SIMENABLE");
             return true;
-        }
-        return false;
-    } else if (strcmp(action, "DISABLE") == 0) {
-        simulationEnabled = false;
-        simulationActive = false;
-        setSimulationMode(false);
-        setTelemetryMode(MODE_FLIGHT);
-        EEPROM.write(EEPROM_SIM_ENABLED_ADDR, 0);
-        EEPROM.write(EEPROM_SIM_ACTIVE_ADDR, 0);
-        setCommandEcho("SIMDISABLE");
-        return true;
+        case SIM_ACTIVATE:
+            if (simulationEnabled) {
+                simulationActive = true;
+                setSimulationMode(true);
+                setTelemetryMode(MODE_SIMULATION);
+                EEPROM.write(EEPROM_SIM_ACTIVE_ADDR, 1);
+                setCommandEcho("SIMACTIVATE");
+                return true;
+            }
+            return false;
+        case SIM_DISABLE:
+            simulationEnabled = false;
+            simulationActive = false;
+            setSimulationMode(false);
+            setTelemetryMode(MODE_FLIGHT);
+            EEPROM.write(EEPROM_SIM_ENABLED_ADDR, 0);
+            EEPROM.write(EEPROM_SIM_ACTIVE_ADDR, 0);
+            setCommandEcho("SIMDISABLE");
+            return true;
+        default:
+            return false;
     }
-    
-    return false;
 }
 
 bool processSIMPCommand(uint32_t pressurePa) {
@@ -132,7 +178,7 @@ bool processSIMPCommand(uint32_t pressurePa) {
     
     setSimulatedPressure(pressurePa);
     char echo[32];
-    snprintf(echo, sizeof(echo), "SIMP%lu", pressurePa);
+    snprintf(echo, sizeof(echo), "SIMP%lu", (unsigned long)pressurePa);
     setCommandEcho(echo);
     return true;
 }
@@ -145,6 +191,27 @@ bool processCALCommand() {
     return true;
 }
 
+// MEC device actions. PAYLOAD = canister separation hatch (servo on pin 2), EGG =
+// egg drop mechanism (servo on pin 5): ON nudges only 10°, which confirms the servo
+// is alive without straining the battery; the full 90° release is triggered by the
+// state machine at PROBE_RELEASE / PAYLOAD_RELEASE, not here.
+// FS1/FS2 = flight surface tests: ON -> 90 deg, OFF -> 0 deg.
+static void mecPayload(bool on) { if (on) nudgeProbe(); }
+static void mecEgg(bool on)     { if (on) nudgePayload(); }
+
+struct MecDevice {
+    const char* name;
+    void (*action)(bool on);
+};
+
+static const MecDevice MEC_DEVICES[] = {
+    { "PAYLOAD", mecPayload },
+    { "EGG", mecEgg },
+    { "FS1", setFlightSurface1Test },
+    { "FS2", setFlightSurface2Test },
+    // Add more device mappings as needed
+};
+
 bool processMECCommand(const char* device, const char* onOff) {
     // MEC - Mechanism: CMD,<TEAM_ID>,MEC,<DEVICE>,<ON_OFF>
     if (device == nullptr || onOff == nullptr) {
@@ -152,29 +219,12 @@ bool processMECCommand(const char* device, const char* onOff) {
     }
     
     bool activate = (strcmp(onOff, "ON") == 0);
-    
-    if (strcmp(device, "PAYLOAD") == 0) {
-        if (activate) {
-            // PAYLOAD = canister separation hatch (servo on pin 2).
-            // Nudge only (10°) — confirms servo is alive without straining the battery.
-            // Full 90° release is triggered by the state machine at PROBE_RELEASE, not here.
-            nudgeProbe();
-        }
-    } else if (strcmp(device, "EGG") == 0) {
-        if (activate) {
-            // EGG = egg drop mechanism (servo on pin 5).
-            // Nudge only (10°) — same battery-safety rationale as PAYLOAD above.
-            // Full 90° release is triggered by the state machine at PAYLOAD_RELEASE.
-            nudgePayload();
+    for (const MecDevice& d : MEC_DEVICES) {
+        if (strcmp(device, d.name) == 0) {
+            d.action(activate);
+            break;
         }
-    } else if (strcmp(device, "FS1") == 0) {
-        // Flight surface 1 test: ON -> 90 deg, OFF -> 0 deg
-        setFlightSurface1Test(activate);
-    } else if (strcmp(device, "FS2") == 0) {
-        // Flight surface 2 test: ON -> 90 deg, OFF -> 0 deg
-        setFlightSurface2Test(activate);
     }
-    // Add more device mappings as needed
     
     char echo[64];
     snprintf(echo, sizeof(echo), "MEC%s%s", device, onOff);
@@ -182,101 +232,835 @@ bool processMECCommand(const char* device, const char* onOff) {
     return true;
 }
 
-bool parseCommand(const char* cmdString) {
-    // Parse command string: CMD,<TEAM_ID>,<COMMAND>,<PARAMS>
-    if (cmdString == nullptr) {
+bool processAGGCommand(const char* onOff) {
+    // AGG - Aggregate telemetry mode: CMD,<TEAM_ID>,AGG,ON|OFF
+    bool on;
+    if (!parseOnOff(onOff, &on)) {
         return false;
     }
-    
-    // Check for "CMD," prefix
-    if (strncmp(cmdString, "CMD,", 4) != 0) {
+
+    setTelemetryAggregateEnabled(on);
+    setCommandEcho(on ? "AGGON" : "AGGOFF");
+    return true;
+}
+
+bool processBINCommand(const char* mode, const char* rate) {
+    // BIN - Binary telemetry side stream: CMD,<TEAM_ID>,BIN,ON|DELTA[,<rate_hz>]|OFF|STATS
+    if (mode == nullptr) {
         return false;
     }
-    
-    // Parse team ID
-    const char* ptr = cmdString + 4;
-    char* endPtr;
-    uint16_t cmdTeamID = (uint16_t)strtoul(ptr, &endPtr, 10);
-    
-    // Verify team ID matches
-    if (cmdTeamID != teamID) {
+
+    bool on = (strcmp(mode, "ON") == 0);
+    bool delta = (strcmp(mode, "DELTA") == 0);
+    if (on || delta) {
+        uint32_t rateHz = BIN_RATE_DEFAULT_HZ;
+        if (rate != nullptr) {
+            rateHz = strtoul(rate, nullptr, 10);
+            if (rateHz < BIN_RATE_MIN_HZ || rateHz > BIN_RATE_MAX_HZ) {
+                return false;
+            }
+        }
+        setBinaryTelemetry(true, (uint8_t)rateHz, delta);
+        char echo[32];
+        snprintf(echo, sizeof(echo), "BIN%s%lu", on ? "ON" : "DELTA", (unsigned long)rateHz);
+        setCommandEcho(echo);
+        return true;
+    } else if (strcmp(mode, "OFF") == 0 && rate == nullptr) {
+        setBinaryTelemetry(false, BIN_RATE_DEFAULT_HZ);
+        setCommandEcho("BINOFF");
+        return true;
+    } else if (strcmp(mode, "STATS") == 0 && rate == nullptr) {
+        BinTelemetryStats st;
+        getBinaryTelemetryStats(&st);
+        // Wire bytes per sent frame in tenths (bytes/sample incl. COBS and delimiters).
+        uint32_t avgTenths = st.framesSent ? (uint32_t)((uint64_t)st.wireBytes * 10 / st.framesSent) : 0;
+        char reply[160];
+        snprintf(reply, sizeof(reply),
+                 "[BIN] %s sent=%lu drop=%lu key=%lu bytes=%lu avg=%lu.%lu enc_cyc=%lu/%lu\r\n",
+                 isBinaryTelemetryEnabled() ? "ON" : "OFF",
+                 (unsigned long)st.framesSent, (unsigned long)st.framesDropped,
+                 (unsigned long)st.keyframes, (unsigned long)st.wireBytes,
+                 (unsigned long)(avgTenths / 10), (unsigned long)(avgTenths % 10),
+                 (unsigned long)st.lastEncodeCycles, (unsigned long)st.maxEncodeCycles);
+        sendCommandReply(reply);
+        BurstStats bs;
+        getBurstStats(&bs);
+        snprintf(reply, sizeof(reply), "[BURST] %s transitions=%lu ev_drop=%lu skipped=%lu samples=%lu\r\n",
+                 isBurstTelemetryEnabled() ? "ON" : "OFF", (unsigned long)bs.transitions,
+                 (unsigned long)bs.eventsDropped, (unsigned long)bs.burstsSkipped,
+                 (unsigned long)bs.samplesSent);
+        sendCommandReply(reply);
+        setCommandEcho("BINSTATS");
+        return true;
+    }
+
+    return false;
+}
+
+// Second-level keyword dispatch for commands with subcommands (LOG, PRM):
+// args.arg[0] is the subcommand; the count range includes it.
+struct Subcommand {
+    const char* word;
+    uint8_t minArgs;
+    uint8_t maxArgs;
+    bool (*handler)(const CommandArgs& args);
+};
+
+static bool dispatchSubcommand(const CommandArgs& args, const Subcommand* table, size_t count) {
+    if (args.count == 0) {
         return false;
     }
-    
-    // Find command type
-    ptr = endPtr + 1;  // Skip comma after team ID
-    if (*ptr == '\0') {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(args.arg[0], table[i].word) == 0) {
+            if (args.count < table[i].minArgs || args.count > table[i].maxArgs) {
+                return false;
+            }
+            return table[i].handler(args);
+        }
+    }
+    return false;
+}
+
+// ---- LOG subcommands ----
+
+static bool logAck(const CommandArgs& args) {
+    if (!logDownlinkAck(strtoul(args.arg[1], nullptr, 10))) {
         return false;
     }
+    setCommandEcho("LOGACK");
+    return true;
+}
 
-    // Find the comma that separates the command token from its parameters.
-    // If no comma exists the remainder IS the command with no parameters
-    // (e.g. "CMD,1057,CAL" is valid; trailing comma is not required).
-    const char* cmdStart = ptr;
-    const char* cmdEnd = strchr(ptr, ',');
-
-    char cmd[8];
-    const char* params = "";
-    if (cmdEnd == nullptr) {
-        // No trailing comma — whole remainder is the command token, no params.
-        size_t cmdLen = strlen(cmdStart);
-        // Strip any trailing \r\n left by the line reader
-        while (cmdLen > 0 && (cmdStart[cmdLen-1] == '\r' || cmdStart[cmdLen-1] == '\n')) {
-            cmdLen--;
+static bool logList(const CommandArgs& args) {
+    char reply[160];
+    uint16_t first = (args.count > 1) ? (uint16_t)strtoul(args.arg[1], nullptr, 10) : 0;
+    if (logDownlinkList(first, reply, sizeof(reply)) == 0) {
+        return false;
+    }
+    sendCommandReply(reply);
+    setCommandEcho("LOGLIST");
+    return true;
+}
+
+static bool logGet(const CommandArgs& args) {
+    uint32_t offset = strtoul(args.arg[2], nullptr, 10);
+    uint32_t length = (args.count > 3) ? strtoul(args.arg[3], nullptr, 10) : 0;
+    if (!logDownlinkStart(args.arg[1], offset, length)) {
+        return false;
+    }
+    char reply[160];
+    LogDownlinkStatus st;
+    getLogDownlinkStatus(&st);
+    snprintf(reply, sizeof(reply), "[LOG] GET %u %s %lu %lu\r\n", (unsigned)st.xferId,
+             st.name, (unsigned long)st.ackOffset, (unsigned long)st.endOffset);
+    sendCommandReply(reply);
+    setCommandEcho("LOGGET");
+    return true;
+}
+
+static bool logStop(const CommandArgs& args) {
+    (void)args;
+    logDownlinkStop();
+    setCommandEcho("LOGSTOP");
+    return true;
+}
+
+static bool logStat(const CommandArgs& args) {
+    (void)args;
+    char reply[160];
+    FlightLogStats s;
+    getFlightLogStats(&s);
+    uint32_t avgUs = s.sectorsWritten ? (uint32_t)(s.totalWriteUs / s.sectorsWritten) : 0;
+    snprintf(reply, sizeof(reply),
+             "[SDLOG] %s %s frames=%lu drop=%lu sectors=%lu busy=%lu ring_max=%lu "
+             "wr_us=%lu/%lu app_cyc=%lu\r\n",
+             getFlightLogName(), isFlightLogActive() ? "ACTIVE" : "OFF",
+             (unsigned long)s.framesLogged, (unsigned long)s.framesDropped,
+             (unsigned long)s.sectorsWritten, (unsigned long)s.busySkips,
+             (unsigned long)s.maxRingSectors, (unsigned long)avgUs,
+             (unsigned long)s.maxWriteUs, (unsigned long)s.maxAppendCycles);
+    sendCommandReply(reply);
+    setCommandEcho("LOGSTAT");
+    return true;
+}
+
+static bool logBlackBoxStat(const CommandArgs& args) {
+    (void)args;
+    char reply[200];
+    BlackBoxStats b;
+    getBlackBoxStats(&b);
+    snprintf(reply, sizeof(reply),
+             "[BBOX] %s segs=%u (%lu..%lu) frames=%lu drop=%lu pages=%lu "
+             "page_us=%lu sync_us=%lu roll_us=%lu slow=%lu erase_us=%lu\r\n",
+             isBlackBoxActive() ? "ACTIVE" : "OFF", (unsigned)b.segmentCount,
+             (unsigned long)b.oldestSegment, (unsigned long)b.newestSegment,
+             (unsigned long)b.framesLogged, (unsigned long)b.framesDropped,
+             (unsigned long)b.pagesWritten, (unsigned long)b.maxPageWriteUs,
+             (unsigned long)b.maxSyncUs, (unsigned long)b.maxRollUs,
+             (unsigned long)b.slowOps, (unsigned long)b.maxEraseUs);
+    sendCommandReply(reply);
+    setCommandEcho("LOGBBSTAT");
+    return true;
+}
+
+static bool logClose(const CommandArgs& args) {
+    (void)args;
+    // Closing drains the ring with busy-waits and truncates the file, stalling the
+    // loop; in flight it would also end the recording. Ground states only.
+    if (!isGroundState(flightState)) {
+        return false;
+    }
+    closeFlightLog();
+    setCommandEcho("LOGCLOSE");
+    return true;
+}
+
+static bool logBench(const CommandArgs& args) {
+    uint32_t sectors = (args.count > 1) ? strtoul(args.arg[1], nullptr, 10) : 2048;  // 1 MB
+    FlightLogBenchResult r;
+    if (!runFlightLogBenchmark(sectors, &r)) {
+        return false;
+    }
+    char reply[160];
+    snprintf(reply, sizeof(reply),
+             "[SDLOG] BENCH sectors=%lu ms=%lu kbps=%lu wr_us=%lu/%lu/%lu busy_us=%lu\r\n",
+             (unsigned long)r.sectors, (unsigned long)(r.elapsedUs / 1000),
+             (unsigned long)r.kbPerSec, (unsigned long)r.minWriteUs,
+             (unsigned long)r.avgWriteUs, (unsigned long)r.maxWriteUs,
+             (unsigned long)r.busyWaitUs);
+    sendCommandReply(reply);
+    setCommandEcho("LOGBENCH");
+    return true;
+}
+
+static const Subcommand LOG_SUBCOMMANDS[] = {
+    { "ACK",    2, 2, logAck },
+    { "LIST",   1, 2, logList },
+    { "GET",    3, 4, logGet },
+    { "STOP",   1, 1, logStop },
+    { "STAT",   1, 1, logStat },
+    { "BBSTAT", 1, 1, logBlackBoxStat },
+    { "CLOSE",  1, 1, logClose },
+    { "BENCH",  1, 2, logBench },
+};
+
+bool processLOGCommand(const CommandArgs& args) {
+    // LOG - SD flight log / black box: CMD,<TEAM_ID>,LOG,STAT|BBSTAT|CLOSE|BENCH[,<sectors>]
+    // Downlink: LOG,LIST[,<first>] | LOG,GET,<name>,<offset>[,<length>] | LOG,ACK,<offset> | LOG,STOP
+    return dispatchSubcommand(args, LOG_SUBCOMMANDS, sizeof(LOG_SUBCOMMANDS) / sizeof(LOG_SUBCOMMANDS[0]));
+}
+
+// ---- PRM subcommands ----
+
+static bool sendParamLine(ParamId id) {
+    const ParamInfo* p = paramInfo(id);
+    char value[16], lo[16], hi[16], def[16];
+    paramFormat(id, param(id), value, sizeof(value));
+    paramFormat(id, p->minValue, lo, sizeof(lo));
+    paramFormat(id, p->maxValue, hi, sizeof(hi));
+    paramFormat(id, p->defaultValue, def, sizeof(def));
+    char reply[128];
+    snprintf(reply, sizeof(reply), "[PRM] %u %s %s %s..%s def=%s%s\r\n", (unsigned)id, p->name,
+             value, lo, hi, def, paramsSavePending() ? " unsaved" : "");
+    sendCommandReply(reply);
+    return true;
+}
+
+static bool prmGet(const CommandArgs& args) {
+    ParamId id;
+    if (!paramFind(args.arg[1], &id)) {
+        return false;
+    }
+    sendParamLine(id);
+    setCommandEcho("PRMGET");
+    return true;
+}
+
+static bool prmSet(const CommandArgs& args) {
+    ParamId id;
+    char* end;
+    float value = strtof(args.arg[2], &end);
+    if (!paramFind(args.arg[1], &id) || *end != '\0' || !paramSet(id, value)) {
+        return false;
+    }
+    sendParamLine(id);
+    char echo[40];
+    snprintf(echo, sizeof(echo), "PRMSET%u", (unsigned)id);
+    setCommandEcho(echo);
+    return true;
+}
+
+static bool prmList(const CommandArgs& args) {
+    // Compact listing: "[PRMLS] <first>/<count> id:NAME=value ..." (4 per line)
+    uint32_t first = (args.count > 1) ? strtoul(args.arg[1], nullptr, 10) : 0;
+    if (first >= PARAM_COUNT) {
+        return false;
+    }
+    char reply[200];
+    const size_t cap = sizeof(reply) - 2;  // Room for CRLF
+    int len = snprintf(reply, cap, "[PRMLS] %lu/%u", (unsigned long)first, (unsigned)PARAM_COUNT);
+    for (uint32_t i = first; i < PARAM_COUNT && i < first + 4 && len > 0 && (size_t)len < cap; i++) {
+        char value[16];
+        paramFormat((ParamId)i, param((ParamId)i), value, sizeof(value));
+        len += snprintf(reply + len, cap - len, " %lu:%s=%s", (unsigned long)i,
+                        paramInfo((ParamId)i)->name, value);
+    }
+    if (len < 0) return false;
+    if ((size_t)len >= cap) len = (int)cap - 1;  // Truncated: keep what fit
+    snprintf(reply + len, sizeof(reply) - len, "\r\n");
+    sendCommandReply(reply);
+    setCommandEcho("PRMLIST");
+    return true;
+}
+
+static bool prmReset(const CommandArgs& args) {
+    (void)args;
+    paramResetAll();
+    setCommandEcho("PRMRESET");
+    return true;
+}
+
+static const Subcommand PRM_SUBCOMMANDS[] = {
+    { "GET",   2, 2, prmGet },
+    { "SET",   3, 3, prmSet },
+    { "LIST",  1, 2, prmList },
+    { "RESET", 1, 1, prmReset },
+};
+
+bool processPRMCommand(const CommandArgs& args) {
+    // PRM - Parameters: CMD,<TEAM_ID>,PRM,GET,<name|id> | SET,<name|id>,<value> | LIST[,<first>] | RESET
+    return dispatchSubcommand(args, PRM_SUBCOMMANDS, sizeof(PRM_SUBCOMMANDS) / sizeof(PRM_SUBCOMMANDS[0]));
+}
+
+// ---- Dispatch table ----
+// One descriptor per command: token, parameter count range, parameter types and
+// handler. parseCommandInPlace() checks arity and types before calling a handler,
+// so handlers only see well-formed parameters.
+//
+// Parameter types, one character per position:
+//   'w' word   - upper-case letters, digits, '_'
+//   'u' number - decimal digits only
+//   '*' any non-empty text (times, file names)
+
+struct CommandDescriptor {
+    const char* token;
+    uint8_t minArgs;
+    uint8_t maxArgs;
+    const char* argTypes;
+    bool (*handler)(const CommandArgs& args);
+};
+
+static bool cmdCX(const CommandArgs& a)   { return processCXCommand(a.arg[0]); }
+static bool cmdST(const CommandArgs& a)   { return processSTCommand(a.arg[0]); }
+static bool cmdSIM(const CommandArgs& a)  { return processSIMCommand(a.arg[0]); }
+static bool cmdSIMP(const CommandArgs& a) { return processSIMPCommand(strtoul(a.arg[0], nullptr, 10)); }
+static bool cmdCAL(const CommandArgs& a)  { (void)a; return processCALCommand(); }
+static bool cmdMEC(const CommandArgs& a)  { return processMECCommand(a.arg[0], a.arg[1]); }
+static bool cmdAGG(const CommandArgs& a)  { return processAGGCommand(a.arg[0]); }
+static bool cmdBIN(const CommandArgs& a)  { return processBINCommand(a.arg[0], a.count > 1 ? a.arg[1] : nullptr); }
+static bool cmdLOG(const CommandArgs& a)  { return processLOGCommand(a); }
+static bool cmdPRM(const CommandArgs& a)  { return processPRMCommand(a); }
+static bool cmdAT(const CommandArgs& a)   { return processATCommand(a); }
+static bool cmdEVT(const CommandArgs& a)  { return processEVTCommand(a.count > 0 ? a.arg[0] : nullptr); }
+static bool cmdFSM(const CommandArgs& a)  { return processFSMCommand(a.count > 0 ? a.arg[0] : nullptr); }
+
+static constexpr CommandDescriptor COMMAND_TABLE[] = {
+    { "CX",   1, 1, "w",    cmdCX },
+    { "ST",   1, 1, "*",    cmdST },
+    { "SIM",  1, 1, "w",    cmdSIM },
+    { "SIMP", 1, 1, "u",    cmdSIMP },
+    { "CAL",  0, 0, "",     cmdCAL },
+    { "MEC",  2, 2, "ww",   cmdMEC },
+    { "AGG",  1, 1, "w",    cmdAGG },
+    { "BIN",  1, 2, "wu",   cmdBIN },
+    { "LOG",  1, 4, "w***", cmdLOG },
+    { "PRM",  1, 3, "w**",  cmdPRM },
+    { "AT",   1, 6, "******", cmdAT },
+    { "EVT",  0, 1, "u",    cmdEVT },
+    { "FSM",  0, 1, "u",    cmdFSM },
+};
+
+static constexpr size_t COMMAND_COUNT = sizeof(COMMAND_TABLE) / sizeof(COMMAND_TABLE[0]);
+
+// Perfect hash: FNV-1a of the token, seeded, folded and masked to COMMAND_HASH_SLOTS
+// (the fold matters: FNV's low bits only depend on the low bits of its input). The
+// seed is searched at compile time so that every token lands in its own slot;
+// a lookup is then one hash, one slot read and one strcmp to reject unknown tokens.
+static constexpr uint8_t COMMAND_HASH_SLOTS = 16;  // Power of two > COMMAND_COUNT
+static constexpr uint32_t COMMAND_NO_SEED = 0xFFFFFFFFUL;
+
+static constexpr uint32_t commandHash(const char* s, uint32_t seed) {
+    uint32_t h = 2166136261UL ^ seed;
+    for (; *s != '\0'; ++s) {
+        h ^= (uint8_t)*s;
+        h *= 16777619UL;
+    }
+    return h ^ (h >> 16);
+}
+
+static constexpr uint8_t commandSlot(const char* s, uint32_t seed) {
+    return (uint8_t)(commandHash(s, seed) & (COMMAND_HASH_SLOTS - 1));
+}
+
+static constexpr bool seedIsPerfect(uint32_t seed) {
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        for (size_t j = 0; j < i; j++) {
+            if (commandSlot(COMMAND_TABLE[i].token, seed) == commandSlot(COMMAND_TABLE[j].token, seed)) {
+                return false;
+            }
         }
-        if (cmdLen == 0 || cmdLen >= sizeof(cmd)) return false;
-        strncpy(cmd, cmdStart, cmdLen);
-        cmd[cmdLen] = '\0';
-    } else {
-        // Normal case: comma found, params follow.
-        size_t cmdLen = cmdEnd - cmdStart;
-        if (cmdLen >= sizeof(cmd)) cmdLen = sizeof(cmd) - 1;
-        strncpy(cmd, cmdStart, cmdLen);
-        cmd[cmdLen] = '\0';
-        params = cmdEnd + 1;
     }
-    
-    // Process command
-    if (strcmp(cmd, "CX") == 0) {
-        return processCXCommand(params);
-    } else if (strcmp(cmd, "ST") == 0) {
-        return processSTCommand(params);
-    } else if (strcmp(cmd, "SIM") == 0) {
-        return processSIMCommand(params);
-    } else if (strcmp(cmd, "SIMP") == 0) {
-        // Pressure in Pascals (e.g. 101325); strtoul stops at non-digit (\r, \n, etc.)
-        uint32_t pressurePa = strtoul(params, nullptr, 10);
-        return processSIMPCommand(pressurePa);
-    } else if (strcmp(cmd, "CAL") == 0) {
-        return processCALCommand();
-    } else if (strcmp(cmd, "MEC") == 0) {
-        // MEC has two parameters: device and on/off
-        const char* deviceEnd = strchr(params, ',');
-        if (deviceEnd == nullptr) {
+    return true;
+}
+
+static constexpr uint32_t findCommandSeed() {
+    for (uint32_t seed = 0; seed < 4096; seed++) {
+        if (seedIsPerfect(seed)) return seed;
+    }
+    return COMMAND_NO_SEED;
+}
+
+static constexpr uint32_t COMMAND_HASH_SEED = findCommandSeed();
+static_assert(COMMAND_COUNT < COMMAND_HASH_SLOTS, "Command table: grow COMMAND_HASH_SLOTS");
+static_assert(COMMAND_HASH_SEED != COMMAND_NO_SEED, "Command table: no collision-free hash seed");
+
+static constexpr bool isArgType(char c) {
+    return c == 'w' || c == 'u' || c == '*';
+}
+
+static constexpr bool descriptorsValid() {
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        const CommandDescriptor& d = COMMAND_TABLE[i];
+        if (d.token == nullptr || d.token[0] == '\0' || d.handler == nullptr) return false;
+        if (d.minArgs > d.maxArgs || d.maxArgs > COMMAND_MAX_ARGS) return false;
+        uint8_t n = 0;
+        for (const char* t = d.argTypes; *t != '\0'; ++t, ++n) {
+            if (!isArgType(*t)) return false;
+        }
+        if (n != d.maxArgs) return false;
+    }
+    return true;
+}
+static_assert(descriptorsValid(), "Command table: bad arity or parameter type string");
+
+// Slot -> table index (-1 = empty), built at compile time.
+struct CommandSlotMap {
+    int8_t index[COMMAND_HASH_SLOTS];
+};
+
+static constexpr CommandSlotMap buildCommandSlots() {
+    CommandSlotMap m{};
+    for (uint8_t s = 0; s < COMMAND_HASH_SLOTS; s++) {
+        m.index[s] = -1;
+    }
+    for (size_t i = 0; i < COMMAND_COUNT; i++) {
+        m.index[commandSlot(COMMAND_TABLE[i].token, COMMAND_HASH_SEED)] = (int8_t)i;
+    }
+    return m;
+}
+
+static constexpr CommandSlotMap COMMAND_SLOTS = buildCommandSlots();
+
+static const CommandDescriptor* findCommand(const char* token) {
+    int8_t i = COMMAND_SLOTS.index[commandSlot(token, COMMAND_HASH_SEED)];
+    if (i < 0 || strcmp(token, COMMAND_TABLE[i].token) != 0) {
+        return nullptr;
+    }
+    return &COMMAND_TABLE[i];
+}
+
+static bool argMatches(const char* s, char type) {
+    if (*s == '\0') return false;
+    if (type == '*') return true;
+    for (; *s != '\0'; ++s) {
+        char c = *s;
+        bool digit = (c >= '0' && c <= '9');
+        if (type == 'u' && !digit) return false;
+        if (type == 'w' && !digit && !(c >= 'A' && c <= 'Z') && c != '_') return false;
+    }
+    return true;
+}
+
+// Arity and per-position type check of args against descriptor d.
+static bool argsMatch(const CommandDescriptor* d, const CommandArgs& args) {
+    if (args.count < d->minArgs || args.count > d->maxArgs) {
+        return false;
+    }
+    for (uint8_t i = 0; i < args.count; i++) {
+        if (!argMatches(args.arg[i], d->argTypes[i])) {
             return false;
         }
-        char device[32];
-        size_t deviceLen = deviceEnd - params;
-        if (deviceLen >= sizeof(device)) {
-            deviceLen = sizeof(device) - 1;
+    }
+    return true;
+}
+
+// ---- AT (time-tagged commands, see CommandScheduler.h) ----
+
+static void formatTimeOfDayMs(uint32_t ms, char* out, size_t cap) {
+    snprintf(out, cap, "%02lu:%02lu:%02lu.%03lu", (unsigned long)(ms / 3600000),
+             (unsigned long)(ms / 60000 % 60), (unsigned long)(ms / 1000 % 60),
+             (unsigned long)(ms % 1000));
+}
+
+static bool atList() {
+    ScheduledCommand pending[AT_MAX_PENDING];
+    uint8_t n = listScheduledCommands(pending, AT_MAX_PENDING);
+    char reply[AT_MAX_LINE + 40];
+    snprintf(reply, sizeof(reply), "[ATLS] %u\r\n", (unsigned)n);
+    sendCommandReply(reply);
+    for (uint8_t i = 0; i < n; i++) {
+        char when[16];
+        formatTimeOfDayMs(pending[i].missionMs, when, sizeof(when));
+        snprintf(reply, sizeof(reply), "[AT] PEND %u %s %s\r\n", (unsigned)pending[i].id, when,
+                 pending[i].line);
+        sendCommandReply(reply);
+    }
+    setCommandEcho("ATLIST");
+    return true;
+}
+
+static bool atCancel(const char* idStr) {
+    if (!argMatches(idStr, 'u')) {
+        return false;
+    }
+    unsigned long id = strtoul(idStr, nullptr, 10);
+    if (id > 0xFFFF || !cancelScheduledCommand((uint16_t)id)) {
+        return false;
+    }
+    char echo[32];
+    snprintf(echo, sizeof(echo), "ATCANCEL%lu", id);
+    setCommandEcho(echo);
+    return true;
+}
+
+bool processATCommand(const CommandArgs& args) {
+    // AT - Time-tagged command: CMD,<TEAM_ID>,AT,<hh:mm:ss[.mmm]>,<COMMAND>[,<PARAMS>...]
+    //      | AT,LIST | AT,CANCEL,<id>
+    if (strcmp(args.arg[0], "LIST") == 0) {
+        return args.count == 1 && atList();
+    }
+    if (strcmp(args.arg[0], "CANCEL") == 0) {
+        return args.count == 2 && atCancel(args.arg[1]);
+    }
+
+    uint32_t missionMs;
+    if (args.count < 2 || !parseTimeOfDayMs(args.arg[0], missionMs)) {
+        return false;
+    }
+    // Validate the inner command now so a typo is rejected while the operator is
+    // still watching, not silently at execution time. No nesting.
+    const CommandDescriptor* inner = findCommand(args.arg[1]);
+    if (inner == nullptr || inner->handler == cmdAT) {
+        return false;
+    }
+    CommandArgs innerArgs;
+    innerArgs.count = (uint8_t)(args.count - 2);
+    for (uint8_t i = 0; i < innerArgs.count; i++) {
+        innerArgs.arg[i] = args.arg[2 + i];
+    }
+    if (!argsMatch(inner, innerArgs)) {
+        return false;
+    }
+
+    // Rebuild the inner command as a complete line for parseCommand() at run time.
+    char line[AT_MAX_LINE];
+    int len = snprintf(line, sizeof(line), "CMD,%u,%s", (unsigned)teamID, args.arg[1]);
+    for (uint8_t i = 0; i < innerArgs.count && len > 0 && (size_t)len < sizeof(line); i++) {
+        len += snprintf(line + len, sizeof(line) - len, ",%s", innerArgs.arg[i]);
+    }
+    uint16_t id;
+    if (len <= 0 || (size_t)len >= sizeof(line) || !scheduleCommand(missionMs, line, &id)) {
+        return false;
+    }
+
+    char when[16];
+    formatTimeOfDayMs(missionMs, when, sizeof(when));
+    char reply[AT_MAX_LINE + 40];
+    snprintf(reply, sizeof(reply), "[AT] ADD %u %s %s\r\n", (unsigned)id, when, line);
+    sendCommandReply(reply);
+    char echo[32];
+    snprintf(echo, sizeof(echo), "AT%u", (unsigned)id);
+    setCommandEcho(echo);
+    return true;
+}
+
+// ---- EVT (event journal readout, see EventJournal.h) ----
+
+bool processEVTCommand(const char* first) {
+    // EVT - Event journal: CMD,<TEAM_ID>,EVT[,<first>]
+    // "[EVTLS] <first>/<head> boot=<n>", then up to 4 lines
+    // "[EVT] <index> <boot> <t_s.us> <NAME> <a> <b>". Default: the newest 4 records.
+    uint32_t head = journalHead();
+    uint32_t oldest = (head > JOURNAL_CAPACITY) ? head - JOURNAL_CAPACITY : 0;
+    uint32_t from = (head > 4) ? head - 4 : 0;
+    if (first != nullptr) {
+        from = strtoul(first, nullptr, 10);
+        if (from < oldest || from >= head) {
+            return false;
         }
-        strncpy(device, params, deviceLen);
-        device[deviceLen] = '\0';
-        const char* onOff = deviceEnd + 1;
-        return processMECCommand(device, onOff);
     }
-    
-    return false;
+    if (from < oldest) from = oldest;
+
+    char reply[96];
+    snprintf(reply, sizeof(reply), "[EVTLS] %lu/%lu boot=%u\r\n", (unsigned long)from,
+             (unsigned long)head, (unsigned)journalBoot());
+    sendCommandReply(reply);
+    for (uint32_t i = from; i < head && i < from + 4; i++) {
+        JournalEntry e;
+        if (!journalRead(i, &e)) continue;
+        snprintf(reply, sizeof(reply), "[EVT] %lu %u %lu.%06lu %s %u %lu\r\n", (unsigned long)i,
+                 (unsigned)e.boot, (unsigned long)(e.timeUs / 1000000ULL),
+                 (unsigned long)(e.timeUs % 1000000ULL), eventIdToString(e.id), (unsigned)e.a,
+                 (unsigned long)e.b);
+        sendCommandReply(reply);
+    }
+    setCommandEcho("EVT");
+    return true;
+}
+
+// ---- FSM (flight transition table stats, see StateLogic.h) ----
+
+bool processFSMCommand(const char* first) {
+    // FSM - Transition table: CMD,<TEAM_ID>,FSM[,<first>]
+    // "[FSMLS] <first>/<rows> <STATE>", then up to 4 lines
+    // "[FSM] <row> <name> <FROM>><TO> n=<fired>/<evaluated> t=<s.us> g=<last>/<max>"
+    // (t = monotonic time the row last fired, g = guard cost in cycles).
+    uint32_t from = (first != nullptr) ? strtoul(first, nullptr, 10) : 0;
+    if (from >= FLIGHT_TRANSITION_COUNT) {
+        return false;
+    }
+    char reply[112];
+    snprintf(reply, sizeof(reply), "[FSMLS] %lu/%u %s\r\n", (unsigned long)from,
+             (unsigned)FLIGHT_TRANSITION_COUNT, flightStateToString(flightState));
+    sendCommandReply(reply);
+    for (uint32_t i = from; i < FLIGHT_TRANSITION_COUNT && i < from + 4; i++) {
+        const FlightTransition& t = FLIGHT_TRANSITIONS[i];
+        FlightTransitionStats st;
+        getFlightTransitionStats(i, &st);
+        snprintf(reply, sizeof(reply), "[FSM] %lu %s %s>%s n=%lu/%lu t=%lu.%06lu g=%lu/%lu\r\n",
+                 (unsigned long)i, t.name, flightStateToString(t.state), flightStateToString(t.next),
+                 (unsigned long)st.fired, (unsigned long)st.evaluations,
+                 (unsigned long)(st.lastFiredUs / 1000000ULL), (unsigned long)(st.lastFiredUs % 1000000ULL),
+                 (unsigned long)st.lastGuardCycles, (unsigned long)st.maxGuardCycles);
+        sendCommandReply(reply);
+    }
+    setCommandEcho("FSM");
+    return true;
+}
+
+// Split line into comma-separated tokens in one pass, overwriting each comma and
+// the line end with '\0'. A trailing CR/LF and one trailing empty field
+// ("CMD,1057,CAL,") are ignored. Returns the token count, or -1 if there are
+// more than maxTokens.
+static int tokenizeInPlace(char* line, char** tokens, uint8_t maxTokens) {
+    uint8_t count = 0;
+    char* start = line;
+    for (char* p = line; ; ++p) {
+        char c = *p;
+        if (c == ',' || c == '\0' || c == '\r' || c == '\n') {
+            *p = '\0';
+            bool last = (c != ',');
+            if (!(last && p == start && count > 0)) {  // Drop a trailing empty field
+                if (count >= maxTokens) return -1;
+                tokens[count++] = start;
+            }
+            if (last) break;
+            start = p + 1;
+        }
+    }
+    return count;
+}
+
+// ---- Acknowledgements ----
+
+// Recently acknowledged (seq, line hash) pairs, so a retry of a command whose ACK
+// was lost is answered without running the command twice. The hash covers the
+// whole line, so a ground station that restarts its sequence numbers with
+// different commands is not mistaken for a retry.
+struct AckRecord {
+    uint32_t lineHash;
+    uint16_t seq;
+    uint8_t result;
+    bool used;
+};
+
+static AckRecord ackHistory[COMMAND_ACK_HISTORY];
+static uint8_t ackHistoryNext = 0;
+
+static uint32_t lineHash(const char* s) {
+    uint32_t h = 2166136261UL;
+    for (; *s != '\0' && *s != '\r' && *s != '\n'; ++s) {
+        h = (h ^ (uint8_t)*s) * 16777619UL;
+    }
+    return h;
+}
+
+static const AckRecord* findAck(uint16_t seq, uint32_t hash) {
+    for (const AckRecord& r : ackHistory) {
+        if (r.used && r.seq == seq && r.lineHash == hash) return &r;
+    }
+    return nullptr;
+}
+
+static void rememberAck(uint16_t seq, uint32_t hash, CommandResult result) {
+    AckRecord& r = ackHistory[ackHistoryNext];
+    r.lineHash = hash;
+    r.seq = seq;
+    r.result = (uint8_t)result;
+    r.used = true;
+    ackHistoryNext = (uint8_t)((ackHistoryNext + 1) % COMMAND_ACK_HISTORY);
+}
+
+static void sendAck(uint16_t seq, CommandResult result, uint32_t rxMicros) {
+    char reply[48];
+    snprintf(reply, sizeof(reply), "[ACK] %u %s %u %lu\r\n", (unsigned)seq,
+             result == CMD_OK ? "OK" : "NACK", (unsigned)result,
+             (unsigned long)(micros() - rxMicros));
+    sendCommandReply(reply);
+    if (result == CMD_OK) {
+        latencyStats.acks++;
+    } else {
+        latencyStats.nacks++;
+    }
+}
+
+// "#<seq>" with 1-5 digits, value <= 65535.
+static bool parseSeqField(const char* s, uint16_t* seq) {
+    if (s[0] != '#' || !argMatches(s + 1, 'u') || strlen(s + 1) > 5) {
+        return false;
+    }
+    unsigned long v = strtoul(s + 1, nullptr, 10);
+    if (v > 0xFFFF) {
+        return false;
+    }
+    *seq = (uint16_t)v;
+    return true;
+}
+
+// Command token onwards: lookup, parameter check, handler.
+static CommandResult dispatchCommandTokens(char** tokens, int n) {
+    const CommandDescriptor* d = findCommand(tokens[0]);
+    if (d == nullptr) {
+        return CMD_ERR_UNKNOWN;
+    }
+    if (n - 1 > COMMAND_MAX_ARGS) {
+        return CMD_ERR_PARAMS;
+    }
+    CommandArgs args;
+    args.count = (uint8_t)(n - 1);
+    for (uint8_t i = 0; i < args.count; i++) {
+        args.arg[i] = tokens[1 + i];
+    }
+    if (!argsMatch(d, args)) {
+        return CMD_ERR_PARAMS;
+    }
+    return d->handler(args) ? CMD_OK : CMD_ERR_REJECTED;
+}
+
+// Run one command and journal it with its result and up to 4 token characters
+// (first character in the low byte).
+static CommandResult runCommandTokens(char** tokens, int n) {
+    uint32_t token = 0;
+    for (uint8_t i = 0; i < 4 && tokens[0][i] != '\0'; i++) {
+        token |= (uint32_t)(uint8_t)tokens[0][i] << (8 * i);
+    }
+    CommandResult result = dispatchCommandTokens(tokens, n);
+    journalEvent(EVT_COMMAND, (uint8_t)result, token);
+    return result;
+}
+
+CommandResult executeCommandLine(char* line, uint32_t rxMicros) {
+    // Format: CMD,<TEAM_ID>,[#<SEQ>,]<COMMAND>[,<PARAMS>...]
+    if (line == nullptr) {
+        return CMD_ERR_FORMAT;
+    }
+    uint32_t hash = lineHash(line);
+
+    // One spare token for the sequence field.
+    char* tokens[4 + COMMAND_MAX_ARGS];
+    int n = tokenizeInPlace(line, tokens, sizeof(tokens) / sizeof(tokens[0]));
+    if (n < 3 || strcmp(tokens[0], "CMD") != 0) {
+        return CMD_ERR_FORMAT;
+    }
+
+    // Verify team ID matches; other teams' commands are never answered.
+    if (!argMatches(tokens[1], 'u') || strtoul(tokens[1], nullptr, 10) != teamID) {
+        return CMD_ERR_TEAM;
+    }
+
+    if (tokens[2][0] != '#') {
+        return runCommandTokens(tokens + 2, n - 2);
+    }
+
+    uint16_t seq;
+    if (!parseSeqField(tokens[2], &seq)) {
+        return CMD_ERR_FORMAT;  // Malformed sequence: nothing to address a NACK to
+    }
+    const AckRecord* prior = findAck(seq, hash);
+    if (prior != nullptr) {
+        latencyStats.duplicates++;
+        sendAck(seq, (CommandResult)prior->result, rxMicros);
+        return (CommandResult)prior->result;
+    }
+    CommandResult result = (n < 4) ? CMD_ERR_FORMAT : runCommandTokens(tokens + 3, n - 3);
+    rememberAck(seq, hash, result);
+    sendAck(seq, result, rxMicros);
+    return result;
+}
+
+bool parseCommandInPlace(char* line) {
+    return executeCommandLine(line, micros()) == CMD_OK;
+}
+
+bool parseCommand(const char* cmdString) {
+    // Copy once into a writable line buffer, then tokenize in place.
+    if (cmdString == nullptr) {
+        return false;
+    }
+    char line[COMMAND_MAX_LINE];
+    size_t len = strlen(cmdString);
+    if (len >= sizeof(line)) {
+        return false;
+    }
+    memcpy(line, cmdString, len + 1);
+    return parseCommandInPlace(line);
+}
+
+void getCommandLatencyStats(CommandLatencyStats* out) {
+    if (out != nullptr) *out = latencyStats;
+}
+
+bool optCmdLatency(const SensorSnapshot& snap, uint32_t* out) {
+    (void)snap;
+    if (latencyStats.commands == 0) return false;
+    *out = latencyStats.lastUs;
+    return true;
+}
+
+bool optCmdLatencyMax(const SensorSnapshot& snap, uint32_t* out) {
+    (void)snap;
+    if (latencyStats.commands == 0) return false;
+    *out = latencyStats.maxUs;
+    return true;
 }
 
 void processCommands() {
-    // Read one complete command line from XBee (if available) and parse it.
-    uint8_t buffer[256];
-    size_t length = 256;
-    
-    if (xbeeReceive(buffer, &length)) {
-        buffer[length] = '\0';  // Null terminate
-        parseCommand((const char*)buffer);
+    // Drain every complete command line queued by the XBee receive path, so a burst
+    // of commands is handled in one tick instead of one per tick.
+    uint8_t buffer[COMMAND_MAX_LINE];
+    uint32_t rxMicros;
+    for (uint8_t i = 0; i < COMMAND_MAX_PER_TICK; i++) {
+        size_t length = sizeof(buffer);
+        if (!xbeeReceiveCommand(buffer, &length, &rxMicros)) {
+            break;
+        }
+        executeCommandLine((char*)buffer, rxMicros);
+
+        uint32_t latency = micros() - rxMicros;
+        latencyStats.commands++;
+        latencyStats.lastUs = latency;
+        latencyStats.totalUs += latency;
+        if (latency > latencyStats.maxUs) latencyStats.maxUs = latency;
     }
 }
 
@@ -0,0 +1,113 @@
+/**
+ * Outbound airtime scheduler for the XBee link.
+ *
+ * The link is a token bucket refilled at the wire rate (baud / 10, less a margin
+ * for radio overhead) and capped at one second of airtime. LINK_TELEMETRY is
+ * admitted unconditionally and may drive the bucket negative, which starves the
+ * lower classes until the wire has caught up. Lower classes are admitted only if
+ * the bucket still holds the next telemetry packet plus a per-class headroom
+ * afterwards; larger headroom for lower classes gives strict priority ordering
+ * among them when airtime is short.
+ */
+#include "LinkScheduler.h"
+#include "XBee.h"
+#include <Arduino.h>
+#include <string.h>
+
+// Fraction of raw UART throughput we plan to use (XBee XSC framing/hops eat the rest).
+static const uint32_t LINK_BUDGET_PCT = 90;
+
+// Initial guess of the mandated packet size; tracks the real size once sent.
+static const int32_t TELEMETRY_RESERVE_DEFAULT = 256;
+
+// Extra airtime (percent of the per-second budget) each class must leave unused.
+static const uint8_t CLASS_HEADROOM_PCT[LINK_CLASS_COUNT] = {
+    0,   // LINK_TELEMETRY (not used: always admitted)
+    0,   // LINK_ACK
+    10,  // LINK_BURST
+    15,  // LINK_STREAM
+    20,  // LINK_DEBUG
+    30   // LINK_LOG
+};
+
+static uint32_t bytesPerSecond = 0;
+static int32_t tokensMilli = 0;        // Available airtime, in 1/1000 byte
+static uint32_t lastRefillMs = 0;
+static int32_t telemetryReserve = TELEMETRY_RESERVE_DEFAULT;
+static LinkClassStats classStats[LINK_CLASS_COUNT];
+
+static int32_t bucketCapMilli() {
+    return (int32_t)bytesPerSecond * 1000;
+}
+
+static void refill() {
+    uint32_t now = millis();
+    uint32_t elapsed = now - lastRefillMs;
+    lastRefillMs = now;
+    if (elapsed > 1000) elapsed = 1000;  // Bucket caps at one second anyway
+
+    tokensMilli += (int32_t)(elapsed * bytesPerSecond);
+    if (tokensMilli > bucketCapMilli()) tokensMilli = bucketCapMilli();
+}
+
+// Bytes a lower class must leave in the bucket after its frame.
+static int32_t classFloorBytes(LinkClass cls) {
+    return telemetryReserve + (int32_t)(bytesPerSecond * CLASS_HEADROOM_PCT[cls] / 100);
+}
+
+void initLinkScheduler() {
+    bytesPerSecond = xbeeBytesPerSecond() * LINK_BUDGET_PCT / 100;
+    tokensMilli = bucketCapMilli();
+    lastRefillMs = millis();
+    telemetryReserve = TELEMETRY_RESERVE_DEFAULT;
+    memset(classStats, 0, sizeof(classStats));
+}
+
+uint32_t linkBytesPerSecond() {
+    return bytesPerSecond;
+}
+
+size_t linkAvailableBytes(LinkClass cls) {
+    if (cls >= LINK_CLASS_COUNT) return 0;
+    refill();
+    if (cls == LINK_TELEMETRY) {
+        return (size_t)bytesPerSecond;
+    }
+    int32_t avail = tokensMilli / 1000 - classFloorBytes(cls);
+    return (avail > 0) ? (size_t)avail : 0;
+}
+
+bool linkSubmit(LinkClass cls, const uint8_t* data, size_t length) {
+    if (cls >= LINK_CLASS_COUNT || data == nullptr || length == 0) return false;
+    LinkClassStats& st = classStats[cls];
+    refill();
+
+    bool admitted;
+    if (cls == LINK_TELEMETRY) {
+        // Strict priority: the mandated packet always goes out if the queue can hold it.
+        telemetryReserve = (int32_t)length;
+        admitted = xbeeSendFrame(data, length, XBEE_PRIORITY_HIGH);
+    } else {
+        int32_t after = tokensMilli - (int32_t)length * 1000;
+        admitted = (after >= classFloorBytes(cls) * 1000) &&
+                   xbeeSendFrame(data, length, XBEE_PRIORITY_LOW);
+    }
+
+    if (!admitted) {
+        st.droppedFrames++;
+        st.droppedBytes += length;
+        return false;
+    }
+
+    tokensMilli -= (int32_t)length * 1000;
+    // Do not let one oversized telemetry line starve everything for more than ~1 s.
+    if (tokensMilli < -bucketCapMilli()) tokensMilli = -bucketCapMilli();
+    st.allocatedFrames++;
+    st.allocatedBytes += length;
+    return true;
+}
+
+void linkGetClassStats(LinkClass cls, LinkClassStats* out) {
+    if (out == nullptr || cls >= LINK_CLASS_COUNT) return;
+    *out = classStats[cls];
+}
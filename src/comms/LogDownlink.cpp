@@ -0,0 +1,176 @@
+// Resumable stored-log downlink (see LogDownlink.h).
+#include "LogDownlink.h"
+#include "BinaryFrame.h"
+#include "BlackBox.h"
+#include "FlightLog.h"
+#include "LinkScheduler.h"
+#include <Arduino.h>
+#include <string.h>
+
+// Wire overhead of one chunk: delimiters, type/version, CRC, COBS code bytes.
+static const size_t CHUNK_OVERHEAD = 2 + 2 + 2 + 2 + BIN_LOG_HEADER_SIZE;
+
+static bool fromBlackBox = false;
+static uint8_t nextXferId = 0;
+static uint32_t lastAckMs = 0;
+static uint32_t lastRewindMs = 0;
+static LogDownlinkStatus dl;
+
+void initLogDownlink() {
+    memset(&dl, 0, sizeof(dl));
+    nextXferId = 0;
+}
+
+// ---- Listing ----
+
+struct ListCtx {
+    char* out;
+    size_t cap;
+    size_t len;
+    uint16_t index;
+    uint16_t first;
+};
+
+static void listEntry(const char* name, uint32_t size, void* p) {
+    ListCtx* ctx = (ListCtx*)p;
+    if (ctx->index >= ctx->first && ctx->index < ctx->first + LOG_DL_LIST_PER_LINE) {
+        int n = snprintf(ctx->out + ctx->len, ctx->cap - ctx->len, " %s:%lu", name,
+                         (unsigned long)size);
+        if (n > 0 && ctx->len + n < ctx->cap) ctx->len += n;
+    }
+    ctx->index++;
+}
+
+size_t logDownlinkList(uint16_t first, char* out, size_t cap) {
+    if (out == nullptr || cap < 32) return 0;
+    char entries[160];
+    entries[0] = '\0';
+    ListCtx ctx = { entries, sizeof(entries), 0, 0, first };
+    flightLogList(listEntry, &ctx);
+    blackBoxList(listEntry, &ctx);
+    int n = snprintf(out, cap, "[LOGLS] %u/%u%s\r\n", (unsigned)first, (unsigned)ctx.index, entries);
+    return n > 0 ? (size_t)n : 0;
+}
+
+// ---- Transfer ----
+
+static void closeSource() {
+    if (fromBlackBox) {
+        blackBoxCloseRead();
+    } else {
+        flightLogCloseRead();
+    }
+}
+
+static int32_t readSource(uint32_t offset, uint8_t* buf, size_t len) {
+    return fromBlackBox ? blackBoxReadAt(offset, buf, len) : flightLogReadAt(offset, buf, len);
+}
+
+static void sendDoneLine(const char* what) {
+    char line[64];
+    snprintf(line, sizeof(line), "[LOG] %s %u %s %lu\r\n", what, (unsigned)dl.xferId, dl.name,
+             (unsigned long)dl.ackOffset);
+    linkSubmit(LINK_ACK, (const uint8_t*)line, strlen(line));
+    Serial.print(line);
+}
+
+bool logDownlinkStart(const char* name, uint32_t offset, uint32_t length) {
+    if (name == nullptr || strlen(name) >= sizeof(dl.name)) return false;
+    if (dl.active) {
+        closeSource();
+        dl.active = false;
+    }
+
+    uint32_t size = 0;
+    fromBlackBox = (strncmp(name, "BB", 2) == 0);
+    bool opened = fromBlackBox ? blackBoxOpenRead(name, &size) : flightLogOpenRead(name, &size);
+    if (!opened || offset > size) {
+        if (opened) closeSource();
+        return false;
+    }
+
+    memset(&dl, 0, sizeof(dl));
+    strcpy(dl.name, name);
+    dl.xferId = ++nextXferId;
+    dl.ackOffset = offset;
+    dl.sendOffset = offset;
+    dl.endOffset = (length == 0 || length > size - offset) ? size : offset + length;
+    dl.active = true;
+    lastAckMs = millis();
+    lastRewindMs = lastAckMs;
+    return true;
+}
+
+bool logDownlinkAck(uint32_t offset) {
+    if (!dl.active || offset < dl.ackOffset || offset > dl.sendOffset) {
+        return false;
+    }
+    dl.ackOffset = offset;
+    lastAckMs = millis();
+    lastRewindMs = lastAckMs;
+    if (dl.ackOffset >= dl.endOffset) {
+        sendDoneLine("DONE");
+        closeSource();
+        dl.active = false;
+    }
+    return true;
+}
+
+void logDownlinkStop() {
+    if (!dl.active) return;
+    closeSource();
+    dl.active = false;
+}
+
+void getLogDownlinkStatus(LogDownlinkStatus* out) {
+    if (out != nullptr) *out = dl;
+}
+
+void updateLogDownlink(uint32_t now_ms) {
+    if (!dl.active) return;
+
+    if (now_ms - lastAckMs >= LOG_DL_ABORT_MS) {
+        sendDoneLine("ABORT");
+        closeSource();
+        dl.active = false;
+        return;
+    }
+    // Go back to the last acknowledged byte if the ground has gone quiet.
+    if (dl.sendOffset > dl.ackOffset && now_ms - lastRewindMs >= LOG_DL_ACK_TIMEOUT_MS) {
+        dl.sendOffset = dl.ackOffset;
+        dl.rewinds++;
+        lastRewindMs = now_ms;
+    }
+
+    uint32_t windowEnd = dl.ackOffset + LOG_DL_WINDOW_BYTES;
+    if (windowEnd > dl.endOffset) windowEnd = dl.endOffset;
+    if (dl.sendOffset >= windowEnd) return;
+
+    size_t avail = linkAvailableBytes(LINK_LOG);
+    if (avail <= CHUNK_OVERHEAD) return;
+    size_t n = avail - CHUNK_OVERHEAD;
+    if (n > BIN_LOG_MAX_DATA) n = BIN_LOG_MAX_DATA;
+    if (n > windowEnd - dl.sendOffset) n = windowEnd - dl.sendOffset;
+    if (n < LOG_DL_MIN_CHUNK && dl.sendOffset + n < dl.endOffset) return;
+
+    uint8_t body[BIN_MAX_BODY];
+    body[0] = dl.xferId;
+    binPutU32(body + 1, dl.sendOffset);
+    int32_t got = readSource(dl.sendOffset, body + BIN_LOG_HEADER_SIZE, n);
+    if (got < 0) {
+        sendDoneLine("ABORT");
+        closeSource();
+        dl.active = false;
+        return;
+    }
+    if (got == 0) return;  // Storage busy
+
+    uint8_t wire[BIN_MAX_WIRE];
+    size_t wireLen = binEncodeFrame(BIN_FRAME_LOG, body, BIN_LOG_HEADER_SIZE + (size_t)got,
+                                    wire, sizeof(wire));
+    if (wireLen > 0 && linkSubmit(LINK_LOG, wire, wireLen)) {
+        dl.sendOffset += (uint32_t)got;
+        dl.chunksSent++;
+        dl.bytesSent += (uint32_t)got;
+    }
+}
@@ -3,6 +3,17 @@
  * Hardware: XBee-Pro XSC 900 MHz (wire antenna on CanSat), SparkFun XBee Explorer Regulated.
  * Teensy 4.1: UART5 (Serial5, RX5/TX5). Serial1 = GPS; Serial2/3 = cameras.
  * Transparent serial mode: bytes sent are transmitted over the air to the other XBee.
+ *
+ * Transmit path: xbeeSend()/xbeeSendFrame() copy whole frames into a static TX ring
+ * and return immediately. updateXBee() moves bytes from the ring into the UART only
+ * as far as availableForWrite() allows, so Serial5.write() never blocks the loop.
+ * At 9600 baud the wire drains ~960 B/s; a telemetry line plus [GPS_RAW] is ~300 ms.
+ *
+ * Receive path: serialEvent5() (run by the core from yield() between loop()
+ * passes, i.e. thousands of times a second) splits bytes into lines as they arrive
+ * and queues each complete line with its arrival time in a fixed ring.
+ * xbeeReceiveCommand() pops queued lines, so the dispatcher can drain every
+ * pending command in one tick.
  */
 #include "XBee.h"
 #include <stddef.h>
@@ -17,17 +28,63 @@
 
 // Command/telemetry lines end with \r or \n
 #define XBEE_LINE_BUF_SIZE 256
+// Complete lines waiting for the dispatcher
+#define XBEE_RX_QUEUE_DEPTH 8
+// Extra UART RX memory so bytes survive a loop stall (flash erase, SD close).
+#define XBEE_UART_EXTRA_RX 512
+
+// Software TX ring (~4 s of airtime at 9600 baud). Power of two for cheap wrap.
+#define XBEE_TX_RING_SIZE 4096
+// Free space LOW-priority frames must leave behind for the next HIGH frame
+// (one full telemetry line with optional fields).
+#define XBEE_TX_HIGH_RESERVE 512
+// Extra UART FIFO memory so one 10 ms tick can hand more than the core's
+// default few dozen bytes to the hardware.
+#define XBEE_UART_EXTRA_TX 256
 
 static bool xbeeReadyFlag = false;
 
+static uint8_t txRing[XBEE_TX_RING_SIZE];
+static size_t txHead = 0;   // Next byte to write into the ring
+static size_t txTail = 0;   // Next byte to hand to the UART
+static size_t txCount = 0;  // Bytes currently in the ring
+static uint8_t uartExtraTx[XBEE_UART_EXTRA_TX];
+static int uartTxCapacity = 0;  // availableForWrite() with an empty UART FIFO
+static XBeeTxStats txStats;
+
 // Line buffer for receiving commands (GCS sends "CMD,1057,CX,ON\r\n" etc.)
 static char lineBuf[XBEE_LINE_BUF_SIZE];
 static size_t lineIdx = 0;
+static bool lineOverflow = false;  // Discarding the rest of an overlong line
+
+struct XBeeRxLine {
+    char text[XBEE_LINE_BUF_SIZE];
+    uint16_t length;
+    uint32_t rxMicros;
+};
+static XBeeRxLine rxQueue[XBEE_RX_QUEUE_DEPTH];
+static uint8_t rxHead = 0;
+static uint8_t rxTail = 0;
+static uint8_t rxCount = 0;
+static uint8_t uartExtraRx[XBEE_UART_EXTRA_RX];
+static XBeeRxStats rxStats;
 
 void initXBee() {
     XBEE_SERIAL.begin(XBEE_BAUD);
+    XBEE_SERIAL.addMemoryForWrite(uartExtraTx, sizeof(uartExtraTx));
+    XBEE_SERIAL.addMemoryForRead(uartExtraRx, sizeof(uartExtraRx));
+    uartTxCapacity = XBEE_SERIAL.availableForWrite();
+    txHead = 0;
+    txTail = 0;
+    txCount = 0;
+    memset(&txStats, 0, sizeof(txStats));
     lineIdx = 0;
     lineBuf[0] = '\0';
+    lineOverflow = false;
+    rxHead = 0;
+    rxTail = 0;
+    rxCount = 0;
+    memset(&rxStats, 0, sizeof(rxStats));
     xbeeReadyFlag = false;
     // Allow UART and XBee to stabilize (Explorer and radio power-up)
     delay(50);
@@ -38,50 +95,170 @@ bool xbeeReady() {
     return xbeeReadyFlag;
 }
 
+uint32_t xbeeBytesPerSecond() {
+    return XBEE_BAUD / 10;  // 1 start + 8 data + 1 stop bit per byte
+}
+
+// Move as many queued bytes into the UART as it will take without blocking.
+static void drainTxRing() {
+    while (txCount > 0) {
+        int space = XBEE_SERIAL.availableForWrite();
+        if (space <= 0) break;
+
+        size_t chunk = XBEE_TX_RING_SIZE - txTail;  // Contiguous run up to the wrap
+        if (chunk > txCount) chunk = txCount;
+        if (chunk > (size_t)space) chunk = (size_t)space;
+
+        XBEE_SERIAL.write(txRing + txTail, chunk);
+        txTail = (txTail + chunk) & (XBEE_TX_RING_SIZE - 1);
+        txCount -= chunk;
+    }
+}
+
 void xbeeSend(const uint8_t* data, size_t length) {
-    if (data == nullptr || length == 0) return;
-    if (!xbeeReadyFlag) return;
-    XBEE_SERIAL.write(data, length);
+    xbeeSendFrame(data, length, XBEE_PRIORITY_HIGH);
 }
 
-/**
- * Non-blocking receive: returns one complete line (terminated by \r or \n).
- * Call repeatedly from loop; when a full line has been received, returns true
- * and the line (without \r\n) is in buffer, length set. Buffer is null-terminated.
- */
-bool xbeeReceive(uint8_t* buffer, size_t* length) {
-    if (buffer == nullptr || length == nullptr || *length == 0) return false;
+bool xbeeSendFrame(const uint8_t* data, size_t length, XBeePriority priority) {
+    if (data == nullptr || length == 0) return false;
+    if (!xbeeReadyFlag) return false;
+
+    size_t freeBytes = XBEE_TX_RING_SIZE - txCount;
+    size_t reserve = (priority == XBEE_PRIORITY_HIGH) ? 0 : XBEE_TX_HIGH_RESERVE;
+    if (length + reserve > freeBytes) {
+        // Whole frame or nothing: a truncated CSV line is worse than a missing one.
+        txStats.framesDropped++;
+        txStats.bytesDropped += length;
+        return false;
+    }
+
+    size_t first = XBEE_TX_RING_SIZE - txHead;
+    if (first > length) first = length;
+    memcpy(txRing + txHead, data, first);
+    memcpy(txRing, data + first, length - first);
+    txHead = (txHead + length) & (XBEE_TX_RING_SIZE - 1);
+    txCount += length;
+
+    txStats.framesQueued++;
+    if (txCount > txStats.peakQueuedBytes) txStats.peakQueuedBytes = txCount;
+
+    // Start the wire immediately rather than waiting for the next updateXBee().
+    drainTxRing();
+    return true;
+}
+
+size_t xbeeTxQueueDepth() {
+    return txCount;
+}
+
+size_t xbeeTxBytesInFlight() {
+    int uartPending = uartTxCapacity - XBEE_SERIAL.availableForWrite();
+    if (uartPending < 0) uartPending = 0;
+    return txCount + (size_t)uartPending;
+}
 
+void xbeeGetTxStats(XBeeTxStats* out) {
+    if (out == nullptr) return;
+    *out = txStats;
+    out->queuedBytes = txCount;
+    out->inFlightBytes = xbeeTxBytesInFlight();
+}
+
+bool optTxInFlight(const SensorSnapshot& snap, uint32_t* out) {
+    (void)snap;
+    *out = (uint32_t)xbeeTxBytesInFlight();
+    return true;
+}
+
+bool optTxDropped(const SensorSnapshot& snap, uint32_t* out) {
+    (void)snap;
+    *out = txStats.framesDropped;
+    return true;
+}
+
+void xbeeGetRxStats(XBeeRxStats* out) {
+    if (out == nullptr) return;
+    *out = rxStats;
+    out->queuedLines = rxCount;
+}
+
+static void queueLine() {
+    if (rxCount >= XBEE_RX_QUEUE_DEPTH) {
+        rxStats.linesDropped++;
+        return;
+    }
+    XBeeRxLine& slot = rxQueue[rxHead];
+    memcpy(slot.text, lineBuf, lineIdx);
+    slot.text[lineIdx] = '\0';
+    slot.length = (uint16_t)lineIdx;
+    slot.rxMicros = micros();
+    rxHead = (rxHead + 1) % XBEE_RX_QUEUE_DEPTH;
+    rxCount++;
+    rxStats.linesQueued++;
+    if (rxCount > rxStats.peakQueuedLines) rxStats.peakQueuedLines = rxCount;
+}
+
+void xbeePollRx() {
     while (XBEE_SERIAL.available()) {
         int c = XBEE_SERIAL.read();
         if (c < 0) break;
 
         if (c == '\r' || c == '\n') {
-            if (lineIdx > 0) {
-                lineBuf[lineIdx] = '\0';
-                size_t copyLen = lineIdx;
-                if (copyLen >= *length) copyLen = *length - 1;
-                memcpy(buffer, lineBuf, copyLen);
-                buffer[copyLen] = '\0';
-                *length = copyLen;
-                lineIdx = 0;
-                return true;
+            if (lineOverflow) {
+                lineOverflow = false;  // End of the discarded line
+            } else if (lineIdx > 0) {
+                queueLine();
             }
+            lineIdx = 0;
             continue;
         }
+        if (lineOverflow) continue;
 
         if (lineIdx < XBEE_LINE_BUF_SIZE - 1) {
             lineBuf[lineIdx++] = (char)c;
         } else {
-            // Overflow: discard and reset
+            // Overlong line: drop it whole, up to its terminator, so its tail is
+            // not parsed as a line of its own.
+            lineOverflow = true;
             lineIdx = 0;
+            rxStats.linesTooLong++;
         }
     }
+}
+
+// Teensy core hook: called from yield() whenever Serial5 has data.
+void serialEvent5() {
+    xbeePollRx();
+}
+
+bool xbeeReceiveCommand(uint8_t* buffer, size_t* length, uint32_t* rxMicros) {
+    if (buffer == nullptr || length == nullptr || *length == 0) return false;
+
+    xbeePollRx();  // Pick up anything that arrived since the last yield()
+    if (rxCount == 0) return false;
 
-    return false;
+    const XBeeRxLine& slot = rxQueue[rxTail];
+    size_t copyLen = slot.length;
+    if (copyLen >= *length) copyLen = *length - 1;
+    memcpy(buffer, slot.text, copyLen);
+    buffer[copyLen] = '\0';
+    *length = copyLen;
+    if (rxMicros != nullptr) *rxMicros = slot.rxMicros;
+    rxTail = (rxTail + 1) % XBEE_RX_QUEUE_DEPTH;
+    rxCount--;
+    return true;
+}
+
+/**
+ * Non-blocking receive: returns the oldest queued complete line (terminated by \r
+ * or \n). The line (without \r\n) is in buffer, null-terminated, length set.
+ */
+bool xbeeReceive(uint8_t* buffer, size_t* length) {
+    return xbeeReceiveCommand(buffer, length, nullptr);
 }
 
 void updateXBee() {
-    // Optional: could poll for errors or buffer full; transparent mode has no link layer.
-    // xbeeReadyFlag remains true once init succeeded.
+    // Transparent mode has no link layer; xbeeReadyFlag remains true once init succeeded.
+    // Keep the UART fed from the TX ring (non-blocking).
+    drainTxRing();
 }
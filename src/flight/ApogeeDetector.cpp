@@ -0,0 +1,83 @@
+// Voting apogee detector (see ApogeeDetector.h).
+#include "ApogeeDetector.h"
+#include "EventJournal.h"
+#include "Params.h"
+#include <math.h>
+#include <string.h>
+
+static const float PAD_NOISE_ALPHA = 0.02f;  // ~50-sample average of squared steps
+
+static ApogeeDetectorStatus det;
+static uint32_t voteHistory = 0;  // Bit 0 = latest sample
+static uint32_t lastSampleMs = 0;
+static float padLastAltitude = 0.0f;
+static uint32_t padLastMs = 0;
+static float padStepVar = 0.0f;   // EWMA of squared sample-to-sample steps
+static uint32_t padSteps = 0;
+
+void resetApogeeDetector() {
+    memset(&det, 0, sizeof(det));
+    voteHistory = 0;
+    lastSampleMs = 0;
+    padLastMs = 0;
+    padStepVar = 0.0f;
+    padSteps = 0;
+}
+
+void apogeeObservePad(float altitude, uint32_t sampleMs) {
+    if (sampleMs == 0 || sampleMs == padLastMs) return;
+    if (padLastMs != 0) {
+        float step = altitude - padLastAltitude;
+        padStepVar = (padSteps == 0) ? step * step
+                                     : padStepVar + PAD_NOISE_ALPHA * (step * step - padStepVar);
+        padSteps++;
+        // Independent noise on both samples: var(step) = 2 sigma^2.
+        det.noiseM = sqrtf(padStepVar * 0.5f);
+    }
+    padLastAltitude = altitude;
+    padLastMs = sampleMs;
+}
+
+static uint8_t countVotes(uint32_t history, uint32_t window) {
+    uint32_t mask = (window >= 32) ? 0xFFFFFFFFUL : ((1UL << window) - 1);
+    return (uint8_t)__builtin_popcount(history & mask);
+}
+
+bool apogeeDetectorUpdate(float altitude, float verticalVel, uint32_t sampleMs) {
+    if (det.detected) return true;
+    if (sampleMs == lastSampleMs || !isfinite(altitude) || !isfinite(verticalVel)) return false;
+    lastSampleMs = sampleMs;
+
+    if (det.samples == 0) {
+        det.maxAltitude = altitude;
+        det.peakMs = sampleMs;
+        det.filtVelocity = verticalVel;
+    } else {
+        det.filtVelocity += param(PRM_APOGEE_VEL_ALPHA) * (verticalVel - det.filtVelocity);
+    }
+    det.samples++;
+    if (altitude > det.maxAltitude) {
+        det.maxAltitude = altitude;
+        det.peakMs = sampleMs;
+    }
+
+    det.thresholdM = fmaxf(param(PRM_APOGEE_MIN_DROP_M), param(PRM_APOGEE_DROP_SIGMA) * det.noiseM);
+    bool vote = det.filtVelocity <= 0.0f && det.maxAltitude - altitude > det.thresholdM;
+    voteHistory = (voteHistory << 1) | (vote ? 1u : 0u);
+
+    uint32_t window = paramU32(PRM_APOGEE_VOTE_M);
+    uint32_t needed = paramU32(PRM_APOGEE_VOTE_N);
+    if (needed > window) needed = window;
+    det.votes = countVotes(voteHistory, window);
+    if (det.votes >= needed) {
+        det.detected = true;
+        det.detectMs = sampleMs;
+        det.latencyMs = sampleMs - det.peakMs;
+        journalEvent(EVT_APOGEE, det.votes, det.latencyMs);
+    }
+    return det.detected;
+}
+
+void getApogeeDetectorStatus(ApogeeDetectorStatus* out) {
+    if (out != nullptr) *out = det;
+}
@@ -1,4 +1,6 @@
 #include "FlightState.h"
+#include "BurstTelemetry.h"
+#include "EventJournal.h"
 #include <Arduino.h>
 #include <EEPROM.h>
 
@@ -23,7 +25,13 @@ void initFlightState() {
 }
 
 void setFlightState(FlightState state) {
+    FlightState previous = flightState;
     flightState = state;
+    if (state != previous) {
+        // Event frame now; pre/post sensor history follows as a burst.
+        journalEvent(EVT_STATE, (uint8_t)previous, (uint32_t)state);
+        onFlightStateTransition(previous, state);
+    }
     EEPROM.write(EEPROM_FLIGHT_STATE_ADDR, (uint8_t)state);
 }
 
@@ -41,3 +49,7 @@ const char* flightStateToString(FlightState state) {
         default:              return "UNKNOWN";
     }
 }
+
+bool isGroundState(FlightState state) {
+    return state == PRELAUNCH || state == LAUNCH_PAD || state == LANDED;
+}
@@ -0,0 +1,152 @@
+// Windowed-variance landing detector (see LandingDetector.h).
+#include "LandingDetector.h"
+#include "EventJournal.h"
+#include "Params.h"
+#include <math.h>
+#include <string.h>
+
+// Sliding window of one signal: mean and sum of squared deviations (m2) updated in
+// O(1) per sample when a sample replaces the oldest one.
+struct WindowStats {
+    float samples[LAND_MAX_WINDOW];
+    float mean;
+    float m2;
+};
+
+static WindowStats altWin;
+static WindowStats accelWin;
+static uint8_t windowSize = 0;  // LAND_WINDOW_SAMPLES the window was filled with
+static uint8_t fill = 0;
+static uint8_t head = 0;        // Slot of the oldest sample once full
+static LandingDetectorStatus status;
+static bool impactJournaled = false;  // EVT_IMPACT written for the latest impact
+
+static void windowAdd(WindowStats& w, float x, uint8_t n) {
+    // Welford's update for a growing window of n samples (n includes x).
+    float delta = x - w.mean;
+    w.mean += delta / n;
+    w.m2 += delta * (x - w.mean);
+}
+
+static void windowReplace(WindowStats& w, float oldX, float newX, uint8_t n) {
+    // Same window size: shift the mean, then correct m2 for both samples.
+    float oldMean = w.mean;
+    w.mean += (newX - oldX) / n;
+    w.m2 += (newX - oldX) * (newX - w.mean + oldX - oldMean);
+    if (w.m2 < 0.0f) w.m2 = 0.0f;  // Rounding
+}
+
+static void windowRecompute(WindowStats& w, uint8_t n) {
+    // Exact two-pass recompute once per window turn so float error cannot build up.
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < n; i++) sum += w.samples[i];
+    w.mean = sum / n;
+    w.m2 = 0.0f;
+    for (uint8_t i = 0; i < n; i++) {
+        float d = w.samples[i] - w.mean;
+        w.m2 += d * d;
+    }
+}
+
+static float windowStd(const WindowStats& w, uint8_t n) {
+    return (n > 1) ? sqrtf(w.m2 / (n - 1)) : 0.0f;
+}
+
+void resetLandingDetector() {
+    memset(&altWin, 0, sizeof(altWin));
+    memset(&accelWin, 0, sizeof(accelWin));
+    memset(&status, 0, sizeof(status));
+    windowSize = 0;
+    fill = 0;
+    head = 0;
+    impactJournaled = false;
+}
+
+bool updateLandingDetector(float altitude, float accelMagnitude, float verticalVel, uint32_t nowMs) {
+    if (status.landed) return true;
+    if (!isfinite(altitude) || !isfinite(accelMagnitude) || !isfinite(verticalVel)) return false;
+
+    uint32_t n = paramU32(PRM_LAND_WINDOW_SAMPLES);
+    if (n > LAND_MAX_WINDOW) n = LAND_MAX_WINDOW;
+    if (n != windowSize) {
+        // Window length changed (PRM,SET): start filling again.
+        fill = 0;
+        head = 0;
+        windowSize = (uint8_t)n;
+        altWin.mean = altWin.m2 = accelWin.mean = accelWin.m2 = 0.0f;
+        status.still = false;
+    }
+
+    uint32_t impactWindowMs = paramU32(PRM_LAND_IMPACT_WINDOW_MS);
+    if (accelMagnitude > param(PRM_LAND_IMPACT_MPS2)) {
+        if (!status.impactSeen || nowMs - status.impactMs > impactWindowMs) {
+            // A new impact, not a bounce of the last one.
+            status.impactPeakMps2 = accelMagnitude;
+            impactJournaled = false;
+        } else if (accelMagnitude > status.impactPeakMps2) {
+            status.impactPeakMps2 = accelMagnitude;
+        }
+        status.impactSeen = true;
+        status.impactMs = nowMs;
+    }
+
+    if (fill < windowSize) {
+        altWin.samples[fill] = altitude;
+        accelWin.samples[fill] = accelMagnitude;
+        fill++;
+        windowAdd(altWin, altitude, fill);
+        windowAdd(accelWin, accelMagnitude, fill);
+    } else {
+        windowReplace(altWin, altWin.samples[head], altitude, windowSize);
+        windowReplace(accelWin, accelWin.samples[head], accelMagnitude, windowSize);
+        altWin.samples[head] = altitude;
+        accelWin.samples[head] = accelMagnitude;
+        if (++head == windowSize) {
+            head = 0;
+            windowRecompute(altWin, windowSize);
+            windowRecompute(accelWin, windowSize);
+        }
+    }
+    status.fill = fill;
+    status.altStdM = windowStd(altWin, fill);
+    status.accelStdMps2 = windowStd(accelWin, fill);
+
+    bool still = fill == windowSize && status.altStdM < param(PRM_LAND_ALT_STD_M) &&
+                 status.accelStdMps2 < param(PRM_LAND_ACCEL_STD_MPS2) &&
+                 fabsf(verticalVel) < param(PRM_LANDED_VZ_MPS);
+    if (still && !status.still) {
+        status.stillSinceMs = nowMs;
+        // Only an impact just before this still stretch is the touchdown.
+        status.impact = status.impactSeen && nowMs - status.impactMs <= impactWindowMs;
+        if (status.impact && !impactJournaled) {
+            // a: how long before the still stretch, 0.1 s
+            uint32_t beforeDs = (nowMs - status.impactMs) / 100;
+            journalEvent(EVT_IMPACT, (uint8_t)(beforeDs > 255 ? 255 : beforeDs),
+                         (uint32_t)(status.impactPeakMps2 * 100.0f));
+            impactJournaled = true;
+        }
+    }
+    status.still = still;
+    if (!still) {
+        status.impact = false;
+        return false;
+    }
+
+    // After a touchdown impact, LAND_CONFIRM_MS of stillness confirms; without, twice that.
+    uint32_t confirmMs = paramU32(PRM_LAND_CONFIRM_MS);
+    if (!status.impact) confirmMs *= 2;
+    if (nowMs - status.stillSinceMs >= confirmMs) {
+        status.landed = true;
+        status.landedMs = nowMs;
+        journalEvent(EVT_LANDING, status.impact ? 1 : 0, nowMs - status.stillSinceMs);
+    }
+    return status.landed;
+}
+
+bool isLandingConfirmed() {
+    return status.landed;
+}
+
+void getLandingDetectorStatus(LandingDetectorStatus* out) {
+    if (out != nullptr) *out = status;
+}
@@ -1,118 +1,254 @@
 // Flight regime transitions (FlightState). Mechanism timing and paraglider guidance
 // live in servos.cpp (updateServos / updateParagliderControl).
 #include "StateLogic.h"
+#include "ApogeeDetector.h"
 #include "FlightState.h"
+#include "LandingDetector.h"
 #include "Sensors.h"
 #include "telemetry.h"
 #include "Timing.h"
 #include "servos.h"
 #include "cameras.h"
+#include "Params.h"
+#include <Arduino.h>
 #include <math.h>
 #include <stdint.h>
 
-static float maxAltitude = 0.0f;  // Peak altitude this flight (for % descent threshold)
-static bool apogeeLatched = false;
-static bool camera1Started = false;
-static bool camera2Started = false;
-static bool launchPadInitialized = false;
-static float launchPadAltitude = 0.0f;
+static FlightContext ctx = {};
 
-void updateFlightState(uint32_t now_ms) {
-    (void)now_ms;
+// ---- Guards (pure: inputs and context only) ----
 
-    float alt = getAltitude();
-    float vel = getVerticalVelocity();
+static bool always(const FlightInputs& in, const FlightContext& c) {
+    (void)in;
+    (void)c;
+    return true;
+}
 
-    switch (flightState) {
+static bool readyOnPad(const FlightInputs& in, const FlightContext& c) {
+    (void)c;
+    // Telemetry link is up and mission time is set; ready on the pad.
+    return in.telemetryUp && in.timeSet;
+}
 
-    case PRELAUNCH:
-        if (telemetryActive() && timeSetComplete()) {
-            // Telemetry link is up and mission time is set; ready on the pad.
-            setFlightState(LAUNCH_PAD);
-            launchPadInitialized = false;  // will initialize on first pass through LAUNCH_PAD
-        }
-        break;
+static bool padNotInitialized(const FlightInputs& in, const FlightContext& c) {
+    (void)in;
+    return !c.launchPadInitialized;
+}
 
-    case LAUNCH_PAD:
-        // Initialize launch pad state once when we first enter LAUNCH_PAD
-        if (!launchPadInitialized) {
-            zeroAltitude();
-            resetServos();
-            // Reset profile-tracking state for a clean flight.
-            maxAltitude = 0.0f;
-            apogeeLatched = false;
-            // Reset camera state in case of re-flight or reset before launch
-            camera1Started = false;
-            camera2Started = false;
-            launchPadAltitude = getAltitude();
-            launchPadInitialized = true;
-        } else {
-            // Stay in LAUNCH_PAD until altitude starts to increase above pad level.
-            // A small threshold (e.g., 5 m) avoids noise.
-            const float ASCENT_THRESHOLD_M = 5.0f;
-            if (alt >= launchPadAltitude + ASCENT_THRESHOLD_M) {
-                setFlightState(ASCENT);
-            }
-        }
-        break;
+static bool climbedOffPad(const FlightInputs& in, const FlightContext& c) {
+    // A small threshold (ASCENT_THRESHOLD_M, default 5 m) avoids noise.
+    return in.altitude >= c.launchPadAltitude + param(PRM_ASCENT_THRESHOLD_M);
+}
 
-    case ASCENT:
-        if (alt > maxAltitude) {
-            maxAltitude = alt;
-        }
+static bool apogeeVoted(const FlightInputs& in, const FlightContext& c) {
+    (void)in;
+    return c.apogeeDetected && !c.apogeeLatched;
+}
 
-        if (vel < 0 && !apogeeLatched) {
-            setFlightState(APOGEE);
-            apogeeLatched = true;
-        }
-        break;
+static bool belowProbeRelease(const FlightInputs& in, const FlightContext& c) {
+    return in.altitude <= param(PRM_PROBE_RELEASE_FRAC) * c.maxAltitude;
+}
 
-    case APOGEE:
-        // Start camera 1 (payload separation camera) at apogee
-        // so it captures separation and early descent.
-        if (!camera1Started) {
-            startCamera1Recording();
-            camera1Started = true;
-        }
-        setFlightState(DESCENT);
-        break;
+static bool belowPayloadRelease(const FlightInputs& in, const FlightContext& c) {
+    (void)c;
+    return in.altitude <= param(PRM_PAYLOAD_RELEASE_ALT_M);
+}
 
-    case DESCENT:
-        if (alt <= 0.8f * maxAltitude) {
-            setFlightState(PROBE_RELEASE);
-        }
-        break;
+static bool landingConfirmed(const FlightInputs& in, const FlightContext& c) {
+    (void)in;
+    return c.landed;
+}
 
-    case PROBE_RELEASE:
-        if (alt <= 2.0f) {
-            setFlightState(PAYLOAD_RELEASE);
-        }
-        break;
-        
+// ---- Actions (all side effects) ----
 
-    case PAYLOAD_RELEASE:
-        if (fabs(vel) < 0.05f) {
-            setFlightState(LANDED);
-        }
-        // Start camera 2 at payload release so egg drop/touchdown are captured.
-        if (!camera2Started) {
-            startCamera2Recording();
-            camera2Started = true;
-        }
-        break;
+static void armForLaunchPad(const FlightInputs& in, FlightContext& c) {
+    (void)in;
+    c.launchPadInitialized = false;  // will initialize on first pass through LAUNCH_PAD
+}
 
-        
+static void initLaunchPad(const FlightInputs& in, FlightContext& c) {
+    (void)in;
+    zeroAltitude();
+    resetServos();
+    // Reset profile-tracking state for a clean flight.
+    c.maxAltitude = 0.0f;
+    c.apogeeDetected = false;
+    c.apogeeLatched = false;
+    resetApogeeDetector();
+    c.landed = false;
+    resetLandingDetector();
+    // Reset camera state in case of re-flight or reset before launch
+    c.camera1Started = false;
+    c.camera2Started = false;
+    c.launchPadAltitude = getAltitude();  // After zeroing, not the tick's stale input
+    c.launchPadInitialized = true;
+}
+
+static void latchApogee(const FlightInputs& in, FlightContext& c) {
+    (void)in;
+    c.apogeeLatched = true;
+}
+
+static void startCamera1(const FlightInputs& in, FlightContext& c) {
+    (void)in;
+    // Camera 1 (payload separation camera) at apogee so it captures separation
+    // and early descent.
+    if (!c.camera1Started) {
+        startCamera1Recording();
+        c.camera1Started = true;
+    }
+}
 
-    case LANDED:
-        // Landing was detected in PAYLOAD_RELEASE (near-zero vertical velocity).
-        if (camera1Started) {
-            stopCamera1Recording();
-            camera1Started = false;
+// ---- During actions (every tick in the state, before its rows) ----
+
+static void learnPadNoise(const FlightInputs& in, FlightContext& c) {
+    (void)c;
+    apogeeObservePad(in.altitude, in.altitudeSampleMs);
+}
+
+static void trackAscent(const FlightInputs& in, FlightContext& c) {
+    if (in.altitude > c.maxAltitude) {
+        c.maxAltitude = in.altitude;
+    }
+    c.apogeeDetected = apogeeDetectorUpdate(in.altitude, in.verticalVel, in.altitudeSampleMs);
+}
+
+// From DESCENT on, so the window is full by touchdown and guidance sees the same
+// landing decision (servos.cpp reads it when guidance is compiled in).
+static void feedLanding(const FlightInputs& in, FlightContext& c) {
+    c.landed = updateLandingDetector(in.altitude, in.accelMagnitude, in.verticalVel, in.nowMs);
+}
+
+static void payloadReleaseDuring(const FlightInputs& in, FlightContext& c) {
+    feedLanding(in, c);
+    // Camera 2 at payload release so egg drop/touchdown are captured.
+    if (!c.camera2Started) {
+        startCamera2Recording();
+        c.camera2Started = true;
+    }
+}
+
+// Low-activity landed regime: cameras off; guidance idles the surfaces (LANDED_MODE)
+// and the logs close on their own LANDED timers.
+static void stopCameras(const FlightInputs& in, FlightContext& c) {
+    (void)in;
+    if (c.camera1Started) {
+        stopCamera1Recording();
+        c.camera1Started = false;
+    }
+    if (c.camera2Started) {
+        stopCamera2Recording();
+        c.camera2Started = false;
+    }
+}
+
+static constexpr uint8_t FLIGHT_STATE_COUNT = (uint8_t)LANDED + 1;
+
+static constexpr FlightAction STATE_DURING[FLIGHT_STATE_COUNT] = {
+    nullptr,           // PRELAUNCH
+    learnPadNoise,     // LAUNCH_PAD
+    trackAscent,       // ASCENT
+    nullptr,           // APOGEE
+    feedLanding,       // DESCENT
+    feedLanding,       // PROBE_RELEASE
+    payloadReleaseDuring,  // PAYLOAD_RELEASE
+    stopCameras,       // LANDED
+};
+
+// Rows grouped by state in enum order; within a state, first passing guard wins.
+constexpr FlightTransition FLIGHT_TRANSITIONS[] = {
+    { PRELAUNCH,       readyOnPad,          armForLaunchPad, LAUNCH_PAD,      "PAD_READY" },
+    { LAUNCH_PAD,      padNotInitialized,   initLaunchPad,   LAUNCH_PAD,      "PAD_INIT" },
+    { LAUNCH_PAD,      climbedOffPad,       nullptr,         ASCENT,          "LIFTOFF" },
+    { ASCENT,          apogeeVoted,         latchApogee,     APOGEE,          "APOGEE" },
+    { APOGEE,          always,              startCamera1,    DESCENT,         "DESCENT" },
+    { DESCENT,         belowProbeRelease,   nullptr,         PROBE_RELEASE,   "PROBE_REL" },
+    { PROBE_RELEASE,   belowPayloadRelease, nullptr,         PAYLOAD_RELEASE, "PAYLOAD_REL" },
+    { PAYLOAD_RELEASE, landingConfirmed,    nullptr,         LANDED,          "LANDED" },
+};
+constexpr size_t FLIGHT_TRANSITION_COUNT = sizeof(FLIGHT_TRANSITIONS) / sizeof(FLIGHT_TRANSITIONS[0]);
+
+// Compile-time checks: rows grouped by state in order, every row has a guard and a
+// valid next state. Then the first row of each state, so a tick only scans its own rows.
+static constexpr bool transitionTableValid() {
+    for (size_t i = 0; i < FLIGHT_TRANSITION_COUNT; i++) {
+        const FlightTransition& t = FLIGHT_TRANSITIONS[i];
+        if (t.guard == nullptr || (uint8_t)t.next >= FLIGHT_STATE_COUNT) return false;
+        if (i > 0 && t.state < FLIGHT_TRANSITIONS[i - 1].state) return false;
+    }
+    return true;
+}
+static_assert(transitionTableValid(), "Flight transition table: rows out of state order, missing guard or bad next state");
+
+struct StateRows {
+    uint8_t first[FLIGHT_STATE_COUNT + 1];
+};
+
+static constexpr StateRows buildStateRows() {
+    StateRows r = {};
+    size_t row = 0;
+    for (uint8_t s = 0; s < FLIGHT_STATE_COUNT; s++) {
+        r.first[s] = (uint8_t)row;
+        while (row < FLIGHT_TRANSITION_COUNT && (uint8_t)FLIGHT_TRANSITIONS[row].state == s) row++;
+    }
+    r.first[FLIGHT_STATE_COUNT] = (uint8_t)row;
+    return r;
+}
+static constexpr StateRows STATE_ROWS = buildStateRows();
+
+static FlightTransitionStats rowStats[FLIGHT_TRANSITION_COUNT];
+
+// Cycle counter for guard cost (Teensy 4.x DWT; micros() elsewhere).
+static inline uint32_t guardClock() {
+#ifdef ARM_DWT_CYCCNT
+    return ARM_DWT_CYCCNT;
+#else
+    return micros();
+#endif
+}
+
+void updateFlightState(uint32_t now_ms) {
+    FlightInputs in;
+    in.altitude = getAltitude();
+    in.verticalVel = getVerticalVelocity();
+    in.altitudeSampleMs = getAltitudeSampleMs();
+    float ax = getAccelRoll(), ay = getAccelPitch(), az = getAccelYaw();
+    in.accelMagnitude = sqrtf(ax * ax + ay * ay + az * az);
+    in.nowMs = now_ms;
+    in.telemetryUp = telemetryActive();
+    in.timeSet = timeSetComplete();
+
+    uint8_t s = (uint8_t)flightState;
+    if (s >= FLIGHT_STATE_COUNT) return;
+    if (STATE_DURING[s] != nullptr) {
+        STATE_DURING[s](in, ctx);
+    }
+
+    for (uint8_t i = STATE_ROWS.first[s]; i < STATE_ROWS.first[s + 1]; i++) {
+        const FlightTransition& t = FLIGHT_TRANSITIONS[i];
+        FlightTransitionStats& st = rowStats[i];
+        uint32_t start = guardClock();
+        bool pass = t.guard(in, ctx);
+        uint32_t cost = guardClock() - start;
+        st.evaluations++;
+        st.lastGuardCycles = cost;
+        if (cost > st.maxGuardCycles) st.maxGuardCycles = cost;
+        if (!pass) continue;
+
+        st.fired++;
+        st.lastFiredUs = getMonotonicUs();
+        if (t.action != nullptr) {
+            t.action(in, ctx);
         }
-        if (camera2Started) {
-            stopCamera2Recording();
-            camera2Started = false;
+        if (t.next != t.state) {
+            setFlightState(t.next);
         }
         break;
     }
 }
+
+bool getFlightTransitionStats(size_t row, FlightTransitionStats* out) {
+    if (row >= FLIGHT_TRANSITION_COUNT || out == nullptr) return false;
+    *out = rowStats[row];
+    return true;
+}
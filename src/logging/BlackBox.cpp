@@ -0,0 +1,331 @@
+// Program/QSPI flash black box (see BlackBox.h).
+//
+// Each update tick makes at most one LittleFS call: roll to a new segment, write
+// one page, sync, or (on the ground) pre-erase one block. A single call can still
+// touch the flash several times, and LittleFS decides on its own when to erase:
+// - Allocating a block goes through the library's erase callback. In the
+//   Teensyduino LittleFS library (libraries/LittleFS/src/LittleFS.cpp) the erase
+//   callbacks return without erasing when blockIsBlank() reads the block as all
+//   0xFF; formatUnused() uses the same check. Blocks pre-erased on the ground
+//   therefore cost a blank-check read instead of an erase. This is a property of
+//   that library, not of littlefs itself: re-check it when the core is updated.
+// - A sync or a segment roll commits to the directory's metadata pair. When the
+//   active metadata block is full, littlefs compacts into the other block of the
+//   pair, which holds old commits, so that erase is real.
+// - Appending after a sync copies the partly written last block of the file to a
+//   new block and frees the old one. Blocks freed in flight are not pre-erased,
+//   so once the allocator has used up the pre-erased space, allocations erase.
+// So erases do happen in flight. A program-flash sector erase stalls everything
+// that executes from flash for tens of ms. The stats record the worst time of each
+// kind of call and count the calls over BLACKBOX_SLOW_OP_US, so the worst case in
+// flight can be read back with LOG,BBSTAT.
+#include "BlackBox.h"
+#include "BinaryFrame.h"
+#include "BinaryTelemetry.h"
+#include "FlightState.h"
+#include "Sensors.h"
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#ifdef BLACKBOX_QSPI
+static LittleFS_QSPIFlash bbfs;
+#else
+static LittleFS_Program bbfs;
+#endif
+
+static File segFile;
+static File readFile;
+static bool bbMounted = false;
+static bool bbActive = false;
+
+static uint32_t oldestSeg = 0;
+static uint32_t nextSeg = 0;
+static uint8_t segCount = 0;
+static uint32_t segBytes = 0;
+static bool segOpen = false;
+
+// Frames accumulate here until a full page can be written; frames may straddle pages.
+static uint8_t pageBuf[2 * BLACKBOX_PAGE_BYTES];
+static uint32_t pageFill = 0;
+static uint16_t bbSeq = 0;
+
+static uint32_t lastSampleMs = 0;
+static uint32_t lastSyncMs = 0;
+static uint32_t lastEraseMs = 0;
+static bool dirtySinceSync = false;
+static uint32_t eraseCursor = 0;
+static uint32_t fsBlocks = 0;
+
+static bool landedSeen = false;
+static uint32_t landedSinceMs = 0;
+
+static BlackBoxStats bbStats;
+
+// "/BB" + up to 10 digits (6 minimum) + ".BIN" + NUL, for any 32-bit sequence.
+static const size_t SEGMENT_NAME_BYTES = 18;
+
+static void segmentName(uint32_t seq, char* out, size_t cap) {
+    snprintf(out, cap, "/BB%06lu.BIN", (unsigned long)seq);
+}
+
+// Worst-case and slow-call bookkeeping for one recording-path LittleFS call.
+static void noteFlashCall(uint32_t us, uint32_t* maxUs) {
+    if (us > *maxUs) *maxUs = us;
+    if (us >= BLACKBOX_SLOW_OP_US) bbStats.slowOps++;
+}
+
+// Flight phases where a flash erase or directory compaction stall is acceptable.
+static bool groundPhase() {
+    return flightState == PRELAUNCH || flightState == LAUNCH_PAD || !bbActive;
+}
+
+// Find the existing segment range left by earlier boots.
+static void scanSegments() {
+    bool any = false;
+    uint32_t lo = 0, hi = 0;
+    segCount = 0;
+    File root = bbfs.open("/");
+    while (root) {
+        File entry = root.openNextFile();
+        if (!entry) break;
+        unsigned long seq;
+        if (!entry.isDirectory() && sscanf(entry.name(), "BB%06lu.BIN", &seq) == 1) {
+            if (!any || seq < lo) lo = seq;
+            if (!any || seq > hi) hi = seq;
+            any = true;
+            segCount++;
+        }
+        entry.close();
+    }
+    root.close();
+    oldestSeg = any ? lo : 0;
+    nextSeg = any ? hi + 1 : 0;
+}
+
+static void deleteOldestSegment() {
+    char name[SEGMENT_NAME_BYTES];
+    while (segCount > 0 && oldestSeg < nextSeg) {
+        segmentName(oldestSeg++, name, sizeof(name));
+        if (bbfs.remove(name)) {
+            segCount--;
+            bbStats.segmentsDeleted++;
+            return;
+        }
+    }
+}
+
+static bool openNextSegment() {
+    if (segOpen) {
+        segFile.close();  // Commits the segment
+        segOpen = false;
+    }
+    uint64_t freeBytes = bbfs.totalSize() - bbfs.usedSize();
+    while (segCount > 0 &&
+           ((groundPhase() && segCount >= BLACKBOX_MAX_SEGMENTS) ||
+            freeBytes < 2 * (uint64_t)BLACKBOX_SEGMENT_BYTES)) {
+        deleteOldestSegment();
+        freeBytes = bbfs.totalSize() - bbfs.usedSize();
+    }
+
+    char name[SEGMENT_NAME_BYTES];
+    segmentName(nextSeg, name, sizeof(name));
+    segFile = bbfs.open(name, FILE_WRITE_BEGIN);
+    if (!segFile) {
+        return false;
+    }
+    segOpen = true;
+    segBytes = 0;
+    segCount++;
+    nextSeg++;
+    bbStats.segmentsOpened++;
+    return true;
+}
+
+void initBlackBox() {
+    bbActive = false;
+    segOpen = false;
+    pageFill = 0;
+    bbSeq = 0;
+    eraseCursor = 0;
+    landedSeen = false;
+    memset(&bbStats, 0, sizeof(bbStats));
+
+#ifdef BLACKBOX_QSPI
+    bbMounted = bbfs.begin();
+#else
+    bbMounted = bbfs.begin(BLACKBOX_FS_BYTES);
+#endif
+    if (!bbMounted) {
+        Serial.println("Black box: flash filesystem unavailable, disabled");
+        return;
+    }
+    fsBlocks = (uint32_t)(bbfs.totalSize() / 4096);
+
+    scanSegments();
+    if (!openNextSegment()) {
+        Serial.println("Black box: cannot create segment, disabled");
+        return;
+    }
+    bbActive = true;
+    lastSyncMs = millis();
+    Serial.print("Black box: segment ");
+    Serial.print((unsigned long)(nextSeg - 1));
+    Serial.print(", ");
+    Serial.print((unsigned long)segCount);
+    Serial.println(" in ring");
+}
+
+bool isBlackBoxActive() {
+    return bbActive;
+}
+
+void getBlackBoxStats(BlackBoxStats* out) {
+    if (out == nullptr) return;
+    *out = bbStats;
+    out->oldestSegment = oldestSeg;
+    out->newestSegment = nextSeg ? nextSeg - 1 : 0;
+    out->segmentCount = segCount;
+}
+
+bool blackBoxFrame(uint8_t type, const uint8_t* body, size_t len) {
+    if (!bbActive) return false;
+    uint8_t wire[BIN_MAX_WIRE];
+    size_t wireLen = binEncodeFrame(type, body, len, wire, sizeof(wire));
+    if (wireLen == 0 || pageFill + wireLen > sizeof(pageBuf)) {
+        bbStats.framesDropped++;
+        return false;
+    }
+    memcpy(pageBuf + pageFill, wire, wireLen);
+    pageFill += wireLen;
+    bbStats.framesLogged++;
+    return true;
+}
+
+static void stopRecording() {
+    if (segOpen) {
+        if (pageFill > 0) {
+            segFile.write(pageBuf, pageFill);
+            pageFill = 0;
+        }
+        segFile.close();
+        segOpen = false;
+    }
+    bbActive = false;
+    Serial.println("Black box: recording stopped");
+}
+
+void updateBlackBox(uint32_t now_ms) {
+    if (!bbMounted) return;
+
+    if (bbActive && now_ms - lastSampleMs >= BLACKBOX_PERIOD_MS) {
+        lastSampleMs = now_ms;
+        SensorSnapshot snap;
+        captureSensorSnapshot(&snap);
+        BinSample sample;
+        binSampleFromSnapshot(snap, (uint8_t)flightState, &sample);
+        sample.seq = bbSeq++;
+        uint8_t body[BIN_SAMPLE_BODY_SIZE];
+        blackBoxFrame(BIN_FRAME_SAMPLE, body, binPackSample(sample, body));
+    }
+
+    if (bbActive) {
+        if (flightState == LANDED) {
+            if (!landedSeen) {
+                landedSeen = true;
+                landedSinceMs = now_ms;
+            } else if (now_ms - landedSinceMs >= BLACKBOX_LANDED_STOP_MS) {
+                stopRecording();
+                return;
+            }
+        } else {
+            landedSeen = false;
+        }
+
+        // One LittleFS call per tick, in priority order.
+        if (segBytes + BLACKBOX_PAGE_BYTES > BLACKBOX_SEGMENT_BYTES) {
+            uint32_t t0 = micros();
+            bool ok = openNextSegment();
+            noteFlashCall(micros() - t0, &bbStats.maxRollUs);
+            if (!ok) {
+                Serial.println("Black box: segment roll failed");
+                bbActive = false;
+            }
+            return;
+        }
+        if (pageFill >= BLACKBOX_PAGE_BYTES) {
+            uint32_t t0 = micros();
+            size_t n = segFile.write(pageBuf, BLACKBOX_PAGE_BYTES);
+            noteFlashCall(micros() - t0, &bbStats.maxPageWriteUs);
+            if (n != BLACKBOX_PAGE_BYTES) {
+                Serial.println("Black box: flash write failed, disabled");
+                bbActive = false;
+                return;
+            }
+            pageFill -= BLACKBOX_PAGE_BYTES;
+            memmove(pageBuf, pageBuf + BLACKBOX_PAGE_BYTES, pageFill);
+            segBytes += BLACKBOX_PAGE_BYTES;
+            bbStats.pagesWritten++;
+            dirtySinceSync = true;
+            return;
+        }
+        if (dirtySinceSync && now_ms - lastSyncMs >= BLACKBOX_SYNC_MS) {
+            lastSyncMs = now_ms;
+            uint32_t t0 = micros();
+            segFile.flush();
+            noteFlashCall(micros() - t0, &bbStats.maxSyncUs);
+            dirtySinceSync = false;
+            return;
+        }
+    }
+
+    if (groundPhase() && fsBlocks > 0 && now_ms - lastEraseMs >= BLACKBOX_ERASE_PERIOD_MS) {
+        lastEraseMs = now_ms;
+        uint32_t t0 = micros();
+        bbfs.formatUnused(1, eraseCursor);
+        uint32_t dt = micros() - t0;
+        if (dt > bbStats.maxEraseUs) bbStats.maxEraseUs = dt;
+        bbStats.eraseAheadCalls++;
+        eraseCursor = (eraseCursor + 1) % fsBlocks;
+    }
+}
+
+void blackBoxList(LogListFn fn, void* ctx) {
+    if (!bbMounted || fn == nullptr) return;
+    File root = bbfs.open("/");
+    while (root) {
+        File entry = root.openNextFile();
+        if (!entry) break;
+        unsigned long seq;
+        if (!entry.isDirectory() && sscanf(entry.name(), "BB%06lu.BIN", &seq) == 1) {
+            fn(entry.name(), (uint32_t)entry.size(), ctx);
+        }
+        entry.close();
+    }
+    root.close();
+}
+
+bool blackBoxOpenRead(const char* name, uint32_t* size) {
+    blackBoxCloseRead();
+    unsigned long seq;
+    if (!bbMounted || name == nullptr || sscanf(name, "BB%06lu.BIN", &seq) != 1) {
+        return false;
+    }
+    if (bbActive && segOpen && seq + 1 == nextSeg) {
+        return false;  // Still being written
+    }
+    char path[SEGMENT_NAME_BYTES];
+    segmentName(seq, path, sizeof(path));
+    readFile = bbfs.open(path, FILE_READ);
+    if (!readFile) return false;
+    if (size != nullptr) *size = (uint32_t)readFile.size();
+    return true;
+}
+
+int32_t blackBoxReadAt(uint32_t offset, uint8_t* buf, size_t len) {
+    if (!readFile || !readFile.seek(offset)) return -1;
+    return readFile.read(buf, len);
+}
+
+void blackBoxCloseRead() {
+    if (readFile) readFile.close();
+}
@@ -0,0 +1,150 @@
+// Reset-surviving flight event journal (see EventJournal.h).
+#include "EventJournal.h"
+#include "BinaryFrame.h"
+#include "BlackBox.h"
+#include "FlightLog.h"
+#include "Timing.h"
+#include <Arduino.h>
+#include <string.h>
+
+static_assert((JOURNAL_CAPACITY & (JOURNAL_CAPACITY - 1)) == 0, "JOURNAL_CAPACITY must be a power of two");
+
+static const uint32_t JOURNAL_MAGIC = 0x4A524E4CUL;  // "JRNL"
+
+// DMAMEM (OCRAM) is not initialized by the startup code, so its contents are
+// still there after a warm reset (watchdog, brownout, program/reset button).
+struct JournalStore {
+    uint32_t magic;
+    uint32_t head;   // Next index to claim
+    uint16_t boot;
+    JournalEntry entries[JOURNAL_CAPACITY];
+};
+DMAMEM static JournalStore journal __attribute__((aligned(32)));
+
+static uint32_t mirrored = 0;  // Next index to forward to the logs
+
+static void flushToRam(const void* p, size_t len) {
+#if defined(__IMXRT1062__)
+    arm_dcache_flush((void*)p, len);
+#else
+    (void)p;
+    (void)len;
+#endif
+}
+
+static void memoryBarrier() {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+void initEventJournal() {
+    // A journal from an earlier boot is trusted only as far as its records check
+    // out: head is rebuilt from the highest published sequence number.
+    bool kept = false;
+    if (journal.magic == JOURNAL_MAGIC) {
+        uint32_t head = 0;
+        for (uint16_t i = 0; i < JOURNAL_CAPACITY; i++) {
+            uint32_t seq = journal.entries[i].seq;
+            if (seq != 0 && ((seq - 1) & (JOURNAL_CAPACITY - 1)) == i && seq > head) {
+                head = seq;
+            }
+        }
+        journal.head = head;
+        journal.boot++;
+        kept = true;
+    }
+    if (!kept) {
+        memset(&journal, 0, sizeof(journal));
+        journal.magic = JOURNAL_MAGIC;
+        journal.boot = 1;
+    }
+    flushToRam(&journal, sizeof(journal));
+
+    // Records that survived the reset are mirrored again into this boot's logs.
+    mirrored = (journal.head > JOURNAL_CAPACITY) ? journal.head - JOURNAL_CAPACITY : 0;
+
+    uint32_t resetReason = 0;
+#ifdef SRC_SRSR
+    resetReason = SRC_SRSR;
+#endif
+    journalEvent(EVT_BOOT, kept ? 1 : 0, resetReason);
+}
+
+void journalEvent(EventId id, uint8_t a, uint32_t b) {
+    uint32_t index = __atomic_fetch_add(&journal.head, 1, __ATOMIC_RELAXED);
+    JournalEntry& e = journal.entries[index & (JOURNAL_CAPACITY - 1)];
+
+    e.seq = 0;  // Unpublish while the payload is rewritten
+    memoryBarrier();
+    e.timeUs = getMonotonicUs();
+    e.boot = journal.boot;
+    e.id = (uint8_t)id;
+    e.a = a;
+    e.b = b;
+    memoryBarrier();
+    e.seq = index + 1;
+    flushToRam(&e, sizeof(e));  // head is rebuilt from seq after a reset
+}
+
+uint32_t journalHead() {
+    return __atomic_load_n(&journal.head, __ATOMIC_RELAXED);
+}
+
+uint16_t journalBoot() {
+    return journal.boot;
+}
+
+bool journalRead(uint32_t index, JournalEntry* out) {
+    if (out == nullptr) return false;
+    const JournalEntry& e = journal.entries[index & (JOURNAL_CAPACITY - 1)];
+    // Copy between two checks of seq so a concurrent rewrite is detected.
+    if (e.seq != index + 1) return false;
+    memoryBarrier();
+    *out = e;
+    memoryBarrier();
+    return e.seq == index + 1 && out->seq == index + 1;
+}
+
+const char* eventIdToString(uint8_t id) {
+    switch (id) {
+        case EVT_BOOT: return "BOOT";
+        case EVT_STATE: return "STATE";
+        case EVT_CAMERA: return "CAMERA";
+        case EVT_COMMAND: return "CMD";
+        case EVT_SENSOR_FAIL: return "SENSOR_FAIL";
+        case EVT_SIM_MODE: return "SIM";
+        case EVT_TIME_SET: return "TIME_SET";
+        case EVT_APOGEE: return "APOGEE";
+        case EVT_IMPACT: return "IMPACT";
+        case EVT_LANDING: return "LANDING";
+        default: return "UNKNOWN";
+    }
+}
+
+void updateEventJournal() {
+    uint32_t head = journalHead();
+    if (head - mirrored > JOURNAL_CAPACITY) {
+        mirrored = head - JOURNAL_CAPACITY;  // Overrun: the oldest records are gone
+    }
+    while (mirrored != head) {
+        JournalEntry e;
+        if (!journalRead(mirrored, &e)) {
+            uint32_t seq = journal.entries[mirrored & (JOURNAL_CAPACITY - 1)].seq;
+            if (seq == 0 || seq <= mirrored) break;  // Claimed but not yet published
+            mirrored++;                              // Overwritten by a newer lap
+            continue;
+        }
+        // BIN_FRAME_EVENT body (20 bytes): index u32, boot u16, id u8, a u8,
+        // time_us u64, b u32.
+        uint8_t body[BIN_EVENT_BODY_SIZE];
+        binPutU32(body, mirrored);
+        binPutU16(body + 4, e.boot);
+        body[6] = e.id;
+        body[7] = e.a;
+        binPutU32(body + 8, (uint32_t)e.timeUs);
+        binPutU32(body + 12, (uint32_t)(e.timeUs >> 32));
+        binPutU32(body + 16, e.b);
+        flightLogFrame(BIN_FRAME_EVENT, body, sizeof(body));
+        blackBoxFrame(BIN_FRAME_EVENT, body, sizeof(body));
+        mirrored++;
+    }
+}
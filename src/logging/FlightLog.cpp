@@ -0,0 +1,292 @@
+// SD flight data recorder (see FlightLog.h).
+//
+// Ring layout: headPos/tailPos count bytes since the file was opened. Frames are
+// appended at headPos; whenever at least one whole sector sits between tailPos
+// and headPos it is written at file offset tailPos. Sectors are contiguous in the
+// ring (its size is a multiple of 512), so each write is one aligned 512-byte
+// block straight from the ring with no copy.
+#include "FlightLog.h"
+#include "BinaryFrame.h"
+#include "BinaryTelemetry.h"
+#include "FlightState.h"
+#include "Sensors.h"
+#include <Arduino.h>
+#include <SdFat.h>
+
+static const uint32_t LOG_RING_BYTES = LOG_RING_SECTORS * LOG_SECTOR_SIZE;
+
+static SdFs sd;
+static FsFile logFile;
+static FsFile readFile;
+static bool sdMounted = false;
+static bool logActive = false;
+static char logName[12] = "";
+
+static uint8_t logRing[LOG_RING_BYTES] __attribute__((aligned(512)));
+static uint32_t headPos = 0;
+static uint32_t tailPos = 0;
+static uint16_t logSeq = 0;
+
+static bool landedSeen = false;
+static uint32_t landedSinceMs = 0;
+
+static FlightLogStats logStats;
+
+// Cycle counter for append cost (Teensy 4.x DWT; micros() elsewhere).
+static inline uint32_t logClock() {
+#ifdef ARM_DWT_CYCCNT
+    return ARM_DWT_CYCCNT;
+#else
+    return micros();
+#endif
+}
+
+void initFlightLog() {
+    logActive = false;
+    headPos = 0;
+    tailPos = 0;
+    logSeq = 0;
+    landedSeen = false;
+    memset(&logStats, 0, sizeof(logStats));
+
+    sdMounted = sd.begin(SdioConfig(FIFO_SDIO));
+    if (!sdMounted) {
+        Serial.println("Flight log: no SD card, logging disabled");
+        return;
+    }
+
+    // Next free FLTnn.BIN
+    uint8_t n = 0;
+    for (; n < 100; n++) {
+        snprintf(logName, sizeof(logName), "FLT%02u.BIN", (unsigned)n);
+        if (!sd.exists(logName)) break;
+    }
+    if (n == 100) {
+        Serial.println("Flight log: FLT00..FLT99 all used, logging disabled");
+        return;
+    }
+
+    logFile = sd.open(logName, O_RDWR | O_CREAT | O_TRUNC);
+    if (!logFile || !logFile.preAllocate(LOG_PREALLOC_BYTES)) {
+        Serial.println("Flight log: cannot preallocate file, logging disabled");
+        logFile.close();
+        return;
+    }
+    // Give the file its full size now (one directory update, on the ground) so
+    // everything written in flight is inside the file even if power is lost
+    // before closeFlightLog() trims it.
+    uint8_t zero = 0;
+    logFile.seekSet(LOG_PREALLOC_BYTES - 1);
+    logFile.write(&zero, 1);
+    logFile.sync();
+    logFile.seekSet(0);
+
+    logActive = true;
+    Serial.print("Flight log: ");
+    Serial.println(logName);
+}
+
+bool isFlightLogActive() {
+    return logActive;
+}
+
+const char* getFlightLogName() {
+    return logName;
+}
+
+void getFlightLogStats(FlightLogStats* out) {
+    if (out != nullptr) *out = logStats;
+}
+
+bool flightLogFrame(uint8_t type, const uint8_t* body, size_t len) {
+    if (!logActive) return false;
+
+    uint32_t t0 = logClock();
+    uint8_t wire[BIN_MAX_WIRE];
+    size_t wireLen = binEncodeFrame(type, body, len, wire, sizeof(wire));
+    uint32_t used = headPos - tailPos;
+    if (wireLen == 0 || used + wireLen > LOG_RING_BYTES ||
+        (uint64_t)headPos + wireLen > LOG_PREALLOC_BYTES) {
+        logStats.framesDropped++;
+        return false;
+    }
+
+    uint32_t at = headPos % LOG_RING_BYTES;
+    uint32_t first = LOG_RING_BYTES - at;
+    if (first > wireLen) first = wireLen;
+    memcpy(logRing + at, wire, first);
+    memcpy(logRing, wire + first, wireLen - first);
+    headPos += wireLen;
+
+    uint32_t cycles = logClock() - t0;
+    if (cycles > logStats.maxAppendCycles) logStats.maxAppendCycles = cycles;
+    uint32_t sectors = (headPos - tailPos) / LOG_SECTOR_SIZE;
+    if (sectors > logStats.maxRingSectors) logStats.maxRingSectors = sectors;
+    logStats.framesLogged++;
+    return true;
+}
+
+// Write the oldest full sector. Returns false if none was ready or the write failed.
+static bool writeSector() {
+    uint32_t t0 = micros();
+    size_t n = logFile.write(logRing + (tailPos % LOG_RING_BYTES), LOG_SECTOR_SIZE);
+    uint32_t dt = micros() - t0;
+    logStats.lastWriteUs = dt;
+    if (dt > logStats.maxWriteUs) logStats.maxWriteUs = dt;
+    logStats.totalWriteUs += dt;
+    if (n != LOG_SECTOR_SIZE) {
+        // Card gone (ejected on landing?) - stop rather than retry every tick.
+        Serial.println("Flight log: SD write failed, logging stopped");
+        logActive = false;
+        return false;
+    }
+    tailPos += LOG_SECTOR_SIZE;
+    logStats.sectorsWritten++;
+    logStats.bytesWritten += LOG_SECTOR_SIZE;
+    return true;
+}
+
+void updateFlightLog(uint32_t now_ms) {
+    if (!logActive) return;
+
+    SensorSnapshot snap;
+    captureSensorSnapshot(&snap);
+    BinSample sample;
+    binSampleFromSnapshot(snap, (uint8_t)flightState, &sample);
+    sample.seq = logSeq++;
+    uint8_t body[BIN_SAMPLE_BODY_SIZE];
+    flightLogFrame(BIN_FRAME_SAMPLE, body, binPackSample(sample, body));
+
+    // One sector per tick at most, and never wait on a busy card.
+    if (headPos - tailPos >= LOG_SECTOR_SIZE) {
+        if (sd.card()->isBusy()) {
+            logStats.busySkips++;
+        } else {
+            writeSector();
+        }
+    }
+
+    if (flightState == LANDED) {
+        if (!landedSeen) {
+            landedSeen = true;
+            landedSinceMs = now_ms;
+        } else if (now_ms - landedSinceMs >= LOG_LANDED_CLOSE_MS) {
+            closeFlightLog();
+        }
+    } else {
+        landedSeen = false;
+    }
+}
+
+void closeFlightLog() {
+    if (!logActive) return;
+
+    // Zero-pad the partial sector (0x00 is the frame delimiter, so padding
+    // decodes as empty frames) and flush everything still in the ring.
+    uint32_t logical = headPos;
+    uint32_t pad = (LOG_SECTOR_SIZE - headPos % LOG_SECTOR_SIZE) % LOG_SECTOR_SIZE;
+    for (uint32_t i = 0; i < pad; i++) {
+        logRing[(headPos + i) % LOG_RING_BYTES] = 0;
+    }
+    headPos += pad;
+    while (logActive && headPos != tailPos) {
+        while (sd.card()->isBusy()) {}
+        writeSector();
+    }
+
+    logFile.truncate(logical);
+    logFile.sync();
+    logFile.close();
+    logActive = false;
+    Serial.print("Flight log: closed ");
+    Serial.print(logName);
+    Serial.print(", ");
+    Serial.print((unsigned long)logical);
+    Serial.println(" bytes");
+}
+
+bool runFlightLogBenchmark(uint32_t sectors, FlightLogBenchResult* out) {
+    if (!sdMounted || out == nullptr || flightState != PRELAUNCH) return false;
+    if (sectors == 0 || sectors > 8192) return false;
+
+    static const char* BENCH_NAME = "BENCH.BIN";
+    FsFile f = sd.open(BENCH_NAME, O_RDWR | O_CREAT | O_TRUNC);
+    if (!f || !f.preAllocate((uint64_t)sectors * LOG_SECTOR_SIZE)) {
+        f.close();
+        sd.remove(BENCH_NAME);
+        return false;
+    }
+
+    // Same access pattern as the logger: aligned 512-byte writes, wait for not-busy.
+    static uint8_t benchSector[LOG_SECTOR_SIZE] __attribute__((aligned(512)));
+    for (uint32_t i = 0; i < LOG_SECTOR_SIZE; i++) {
+        benchSector[i] = (uint8_t)i;
+    }
+    memset(out, 0, sizeof(*out));
+    out->minWriteUs = 0xFFFFFFFFUL;
+    uint64_t totalWriteUs = 0;
+    bool ok = true;
+
+    uint32_t start = micros();
+    for (uint32_t s = 0; s < sectors && ok; s++) {
+        uint32_t w0 = micros();
+        while (sd.card()->isBusy()) {}
+        uint32_t t0 = micros();
+        out->busyWaitUs += t0 - w0;
+        ok = f.write(benchSector, LOG_SECTOR_SIZE) == LOG_SECTOR_SIZE;
+        uint32_t dt = micros() - t0;
+        totalWriteUs += dt;
+        if (dt < out->minWriteUs) out->minWriteUs = dt;
+        if (dt > out->maxWriteUs) out->maxWriteUs = dt;
+        out->sectors++;
+    }
+    f.sync();
+    out->elapsedUs = micros() - start;
+    f.close();
+    sd.remove(BENCH_NAME);
+
+    if (out->sectors > 0) {
+        out->avgWriteUs = (uint32_t)(totalWriteUs / out->sectors);
+    }
+    if (out->elapsedUs > 0) {
+        out->kbPerSec = (uint32_t)((uint64_t)out->sectors * LOG_SECTOR_SIZE * 1000000ULL /
+                                   1024ULL / out->elapsedUs);
+    }
+    return ok;
+}
+
+void flightLogList(LogListFn fn, void* ctx) {
+    if (!sdMounted || fn == nullptr) return;
+    FsFile root = sd.open("/");
+    FsFile f;
+    char name[16];
+    while (f.openNext(&root, O_RDONLY)) {
+        if (!f.isDir() && f.getName(name, sizeof(name)) > 0 && strncmp(name, "FLT", 3) == 0) {
+            bool recording = logActive && strcmp(name, logName) == 0;
+            fn(name, recording ? headPos : (uint32_t)f.fileSize(), ctx);
+        }
+        f.close();
+    }
+    root.close();
+}
+
+bool flightLogOpenRead(const char* name, uint32_t* size) {
+    flightLogCloseRead();
+    if (!sdMounted || name == nullptr || (logActive && strcmp(name, logName) == 0)) {
+        return false;
+    }
+    readFile = sd.open(name, O_RDONLY);
+    if (!readFile) return false;
+    if (size != nullptr) *size = (uint32_t)readFile.fileSize();
+    return true;
+}
+
+int32_t flightLogReadAt(uint32_t offset, uint8_t* buf, size_t len) {
+    if (!readFile.isOpen() || !readFile.seekSet(offset)) return -1;
+    if (sd.card()->isBusy()) return 0;  // Logger write in progress; try next tick
+    return readFile.read(buf, len);
+}
+
+void flightLogCloseRead() {
+    if (readFile.isOpen()) readFile.close();
+}
@@ -4,9 +4,19 @@
 #include "Sensors.h"
 #include "Timing.h"
 #include "telemetry.h"
+#include "TelemetryAggregate.h"
+#include "BinaryTelemetry.h"
+#include "BurstTelemetry.h"
+#include "FlightLog.h"
+#include "BlackBox.h"
+#include "LogDownlink.h"
 #include "XBee.h"
+#include "LinkScheduler.h"
 #include "servos.h"
 #include "Commands.h"
+#include "CommandScheduler.h"
+#include "EventJournal.h"
+#include "Params.h"
 #include "cameras.h"
 
 // Main loop timing
@@ -26,14 +36,24 @@ void setup() {
     // Set team ID for command processing
     setTeamID(TEAM_ID);
     
-    // Initialize all subsystems
+    // Initialize all subsystems (parameters first: others read them)
+    initParams();
+    initEventJournal();  // Before any module that journals events
     initTiming();
     initSensors();
     initXBee();
+    initLinkScheduler();
     initTelemetry();
+    initTelemetryAggregate();
+    initBinaryTelemetry();
+    initBurstTelemetry();
+    initFlightLog();
+    initBlackBox();
+    initLogDownlink();
     initServos();
     initCameras();
     initCommands();
+    initCommandScheduler();
     // Re-assert team ID after initCommands() to avoid any ordering/regression issues.
     setTeamID(TEAM_ID);
     
@@ -59,6 +79,10 @@ void setup() {
 
 void loop() {
     uint32_t now_ms = millis();
+
+    // Time-tagged (AT) commands run on every pass, not only on the 100 Hz tick, so
+    // they start within a loop pass of their deadline.
+    updateCommandScheduler();
     
     // High frequency main loop (100 Hz) 
     if (now_ms - lastLoopTime >= MAIN_LOOP_PERIOD_MS) {
@@ -67,14 +91,30 @@ void loop() {
         // Update all subsystems
         updateTiming();
         updateSensors();
+        updateTelemetryAggregate();  // AGG mode: accumulate this tick's sample
         updateXBee();
         updateCommands();  // Process commands frequently
         
         // Update flight state based on sensor readings
         updateFlightState(now_ms);
+        // Save parameter changes made in flight once back on the ground
+        updateParams();
         
         // Update servos based on current flight state
         updateServos();
+
+        // Binary side stream (BIN command); uses spare airtime only
+        updateBinaryTelemetry(now_ms);
+        // Transition bursts: 20 Hz history + pending burst chunks
+        updateBurstTelemetry(now_ms);
+        // Event journal: mirror new records into the flight log and black box
+        updateEventJournal();
+        // SD flight recorder: log this tick's snapshot, write at most one sector
+        updateFlightLog(now_ms);
+        // Flash black box (SD fallback): 50 Hz, pre-erased blocks only in flight
+        updateBlackBox(now_ms);
+        // Stored-log downlink (LOG,GET); lowest-priority airtime only
+        updateLogDownlink(now_ms);
     }
     
     // Send telemetry at exactly 1 Hz (required: X4, C9)
@@ -1,4 +1,6 @@
 #include "Sensors.h"
+#include "EventJournal.h"
+#include "Timing.h"
 #include <Arduino.h>
 #include <Wire.h>
 #include <EEPROM.h>
@@ -23,11 +25,21 @@ static float currentCurrent = 0.0f;       // Battery current (A)
 static float currentGyroR = 0.0f, currentGyroP = 0.0f, currentGyroY = 0.0f;
 static float currentAccelR = 0.0f, currentAccelP = 0.0f, currentAccelY = 0.0f;
 static float altitudeOffset = 0.0f;
-static float previousAltitude = 0.0f;
-static uint32_t lastUpdateTime = 0;
+static float previousAltitude = 0.0f;      // Altitude at the previous baro (or SIMP) sample
+static uint32_t previousAltitudeMs = 0;    // millis() of that sample
+static float currentVerticalVelocity = 0.0f;
+static uint32_t lastUpdateTime = 0;        // millis() of the last updateSensors() read
+
+// Vertical velocity low-pass time constant. Differentiating 50 Hz baro samples
+// directly is dominated by noise; ~0.15 s keeps lag small at ascent/descent rates.
+static const float VZ_FILTER_TAU_S = 0.15f;
 
 // GPS data
 static uint8_t gpsHour = 0, gpsMinute = 0, gpsSecond = 0;
+// First sentence of each GPS fix epoch: its time of day and when it finished arriving.
+static uint32_t gpsEpochCount = 0;
+static uint32_t gpsEpochMsOfDay = 0;
+static uint64_t gpsEpochArrivalUs = 0;
 static float gpsAltitude = 0.0f;
 static float gpsLatitude = 0.0f;
 static float gpsLongitude = 0.0f;
@@ -86,6 +98,7 @@ void initSensors() {
         bmp.setOutputDataRate(BMP3_ODR_50_HZ);
     } else {
         bmpInitialized = false;
+        journalEvent(EVT_SENSOR_FAIL, JSENSOR_BMP390);
     }
 
     // Brief delay so the I2C bus is idle before the next device init.
@@ -99,10 +112,14 @@ void initSensors() {
     // behaviour matches the standalone test sketch; isfinite() guards below
     // prevent bad values reaching telemetry.
     ina219Initialized = ina219.begin();
+    if (!ina219Initialized) {
+        journalEvent(EVT_SENSOR_FAIL, JSENSOR_INA219);
+    }
 
     // Initialize BNO055 IMU
     if (!bno.begin()) {
         bnoInitialized = false;
+        journalEvent(EVT_SENSOR_FAIL, JSENSOR_BNO055);
     } else {
         bnoInitialized = true;
         // Use external crystal for better accuracy if available
@@ -121,13 +138,32 @@ void initSensors() {
     }
 
     previousAltitude = 0.0f;
+    previousAltitudeMs = 0;
+    currentVerticalVelocity = 0.0f;
     lastUpdateTime = millis();
 }
 
+// Differentiate altitude once per NEW sample (baro read or SIMP), using the sample
+// timestamps, so velocity does not depend on when or how often it is queried.
+static void onAltitudeSample(uint32_t sampleMs) {
+    if (previousAltitudeMs != 0 && sampleMs > previousAltitudeMs) {
+        float dt = (sampleMs - previousAltitudeMs) / 1000.0f;
+        float raw = (currentAltitude - previousAltitude) / dt;
+        float alpha = dt / (VZ_FILTER_TAU_S + dt);
+        currentVerticalVelocity += alpha * (raw - currentVerticalVelocity);
+    }
+    previousAltitude = currentAltitude;
+    previousAltitudeMs = sampleMs;
+}
+
 float getAltitude() {
     return currentAltitude;
 }
 
+uint32_t getAltitudeSampleMs() {
+    return previousAltitudeMs;
+}
+
 float getPressure() {
     // In simulation mode, return simulated pressure converted to kPa
     if (simulationModeActive) {
@@ -179,6 +215,12 @@ bool getGPSTime(uint8_t& hour, uint8_t& minute, uint8_t& second) {
     return gpsSatellites > 0;  // Return true if GPS has fix
 }
 
+uint32_t getGPSTimeEpoch(uint32_t& msOfDay, uint64_t& arrivalUs) {
+    msOfDay = gpsEpochMsOfDay;
+    arrivalUs = gpsEpochArrivalUs;
+    return (gpsSatellites > 0) ? gpsEpochCount : 0;
+}
+
 float getGPSAltitude() {
     return gpsAltitude;
 }
@@ -196,15 +238,8 @@ uint8_t getGPSSatellites() {
 }
 
 float getVerticalVelocity() {
-    // Calculate vertical velocity from altitude change
-    uint32_t now = millis();
-    if (lastUpdateTime > 0 && now > lastUpdateTime) {
-        float dt = (now - lastUpdateTime) / 1000.0f;  // Convert to seconds
-        if (dt > 0) {
-            return (currentAltitude - previousAltitude) / dt;
-        }
-    }
-    return 0.0f;
+    // Computed when each altitude sample arrives (onAltitudeSample), not at query time.
+    return currentVerticalVelocity;
 }
 
 static float wrapAngle360(float deg) {
@@ -241,6 +276,54 @@ bool getHeadingReferenceDeg(float* outHeadingDeg, uint8_t* source) {
     return false;
 }
 
+void captureSensorSnapshot(SensorSnapshot* out) {
+    if (out == nullptr) return;
+
+    // All values come from the last updateSensors() pass; nothing is re-read here,
+    // so every field describes the same instant (captureMs).
+    out->captureMs = lastUpdateTime;
+    out->altitude = getAltitude();
+    out->pressure = getPressure();
+    out->temperature = getTemperature();
+    out->voltage = getBatteryVoltage();
+    out->current = getBatteryCurrent();
+    out->gyroR = currentGyroR;
+    out->gyroP = currentGyroP;
+    out->gyroY = currentGyroY;
+    out->accelR = currentAccelR;
+    out->accelP = currentAccelP;
+    out->accelY = currentAccelY;
+    out->gpsTimeValid = getGPSTime(out->gpsHour, out->gpsMinute, out->gpsSecond);
+    out->gpsAltitude = gpsAltitude;
+    out->gpsLatitude = gpsLatitude;
+    out->gpsLongitude = gpsLongitude;
+    out->gpsSatellites = gpsSatellites;
+    out->verticalVelocity = currentVerticalVelocity;
+    out->headingSource = 0;
+    out->headingDeg = 0.0f;
+    out->headingValid = getHeadingReferenceDeg(&out->headingDeg, &out->headingSource);
+}
+
+bool optCaptureMs(const SensorSnapshot& snap, uint32_t* out) {
+    *out = snap.captureMs;
+    return true;
+}
+
+bool optVerticalVelocity(const SensorSnapshot& snap, float* out) {
+    *out = snap.verticalVelocity;
+    return true;
+}
+
+bool optHeadingDeg(const SensorSnapshot& snap, float* out) {
+    *out = snap.headingDeg;
+    return snap.headingValid;
+}
+
+bool optHeadingSource(const SensorSnapshot& snap, uint32_t* out) {
+    *out = snap.headingSource;  // 0 = none, 1 = GPS COG, 2 = BNO055
+    return true;
+}
+
 void zeroAltitude() {
     // Calibrate altitude to zero at launch pad (required: G1, CAL command)
     // Store current altitude reading as offset and persist it (F8).
@@ -254,6 +337,9 @@ void zeroAltitude() {
 }
 
 void setSimulationMode(bool enabled) {
+    if (enabled != simulationModeActive) {
+        journalEvent(EVT_SIM_MODE, enabled ? 1 : 0);
+    }
     simulationModeEnabled = enabled;
     simulationModeActive = enabled;  // Both required so getPressure() and updateSensors() use simulated values
 }
@@ -267,6 +353,7 @@ void setSimulatedPressure(float pressure_pa) {
     const float P0 = 101325.0f;  // Sea level pressure in Pa
     currentAltitude = 44330.0f * (1.0f - powf(pressure_pa / P0, 0.1903f)); // barometric formula
     currentPressure = pressure_pa / 1000.0f;  // Convert to kPa
+    onAltitudeSample(millis());
 }
 
 void updateSensors() {
@@ -288,6 +375,7 @@ void updateSensors() {
             const float P0 = 101325.0f;  // Sea level pressure in Pa
             float calculatedAltitude = 44330.0f * (1.0f - powf(pressurePa / P0, 0.1903f));
             currentAltitude = calculatedAltitude - altitudeOffset;
+            onAltitudeSample(now);
         }
 
         // --- INA219: battery voltage and current ---
@@ -325,7 +413,16 @@ void updateSensors() {
         // --- GPS: parse NMEA sentences from GPS_SERIAL using TinyGPSPlus ---
         while (GPS_SERIAL.available() > 0) {
             char c = (char)GPS_SERIAL.read();
-            gpsParser.encode(c);
+            if (gpsParser.encode(c) && gpsParser.time.isUpdated() && gpsParser.time.isValid()) {
+                // Several sentences carry the same epoch; keep only the first to arrive.
+                uint32_t ms = (((uint32_t)gpsParser.time.hour() * 60 + gpsParser.time.minute()) * 60 +
+                               gpsParser.time.second()) * 1000UL + gpsParser.time.centisecond() * 10UL;
+                if (gpsEpochCount == 0 || ms != gpsEpochMsOfDay) {
+                    gpsEpochMsOfDay = ms;
+                    gpsEpochArrivalUs = getMonotonicUs();
+                    gpsEpochCount++;
+                }
+            }
 
             // Build raw NMEA buffer for debug. Each sentence ends with \n.
             if (c == '\n') {
@@ -369,10 +466,6 @@ void updateSensors() {
         }
     }
     
-    // Update vertical velocity calculation
-    if (lastUpdateTime > 0) {
-        previousAltitude = currentAltitude;
-    }
     lastUpdateTime = now;
 }
 
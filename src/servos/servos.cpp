@@ -28,6 +28,8 @@
 // flight — see notice above. Nothing in this block is compiled.
 #include <Servo.h>
 #include <math.h>
+#include "Params.h"
+#include "LandingDetector.h"
 
 // ================= PINS =================
 
@@ -60,58 +62,12 @@ static uint32_t lastParagliderUpdate = 0;
 
 // ================= AUTONOMOUS DESCENT SETTINGS =================
 
-// Stage timing
-static const uint32_t STABILIZE_TIME_MS  = 3500;
-static const uint32_t MIN_STAGE_DWELL_MS = 1200;
-
-// Distance / altitude thresholds
-static const float FAR_DISTANCE_M        = 40.0f;
-static const float SPIRAL_DISTANCE_M     = 15.0f;
-static const float FINAL_APPROACH_ALT_M  = 15.0f;
-static const float RELEASE_ZONE_ALT_M    = 5.0f;
-static const float EGG_RELEASE_ALT_M     = 2.0f;
-
-// Guidance / control
-static const float MIN_VALID_SATS        = 4.0f;
-
-// Gyro yaw-rate damping on lateral command (deg/s -> deg command)
-static const float GYRO_DAMP_GAIN_FAR    = 0.30f;
-static const float GYRO_DAMP_GAIN_MID    = 0.40f;
-static const float GYRO_DAMP_GAIN_FINAL  = 0.50f;
-
-// Heading-error gain when GPS COG or IMU heading is available (deg command per deg error)
-static const float HEADING_KP_FAR        = 0.32f;
-static const float HEADING_KP_MID        = 0.38f;
-static const float HEADING_KP_SPIRAL     = 0.42f;
-static const float HEADING_KP_FINAL      = 0.28f;
-static const float HEADING_KP_RELEASE    = 0.24f;
-
-// Fallback coarse turn when no heading reference (bearing hemisphere only)
-static const float BASE_TURN_FAR         = 10.0f;
-static const float BASE_TURN_MID         = 14.0f;
-static const float BASE_TURN_SPIRAL      = 16.0f;
-static const float BASE_TURN_FINAL       = 8.0f;
-
-// Vertical descent rate (C7): baro vz is positive up; target ~ -5 m/s
-static const float VZ_CMD_MPS            = -5.0f;
-static const float VZ_LPF_ALPHA          = 0.35f;
-static const float VZ_KP                 = 0.85f;
-static const float VZ_KI                 = 0.20f;
-static const float VZ_INT_MAX            = 4.0f;
-static const float VZ_DELTA_CLAMP        = 7.0f;
-
-// Symmetric braking values
-static const float SYM_BRAKE_NONE        = 0.0f;
-static const float SYM_BRAKE_SPIRAL      = 3.0f;
-static const float SYM_BRAKE_FINAL       = 4.0f;
-static const float SYM_BRAKE_RELEASE     = 2.0f;
-
-// Spiral mode
-static const uint32_t MAX_SPIRAL_TIME_MS = 6000;
+// Stage timing, thresholds, guidance gains, vertical-rate PI, braking and the
+// landed check are runtime parameters (Params.h, PRM command): read them with
+// param(PRM_<NAME>) / paramU32(PRM_<NAME>).
 
-// Internal paraglider stage: baro vz near zero and low AGL (see getVerticalVelocity)
-static const float LANDED_ALT_M          = 1.0f;
-static const float LANDED_VZ_MPS         = 0.3f;
+// Symmetric braking with no brake applied
+static const float SYM_BRAKE_NONE        = 0.0f;
 
 // ================= SERVO OBJECTS =================
 
@@ -237,7 +193,7 @@ static void enterDescentStage(DescentStage nextStage) {
 // Thin wrappers around Sensors.h for paraglider logic.
 
 static bool gpsUsable() {
-    return getGPSSatellites() >= (uint8_t)MIN_VALID_SATS;
+    return getGPSSatellites() >= paramU32(PRM_MIN_VALID_SATS);
 }
 
 static float currentLat() {
@@ -262,8 +218,8 @@ static float currentYawRateDegPerSec() {
 }
 
 static bool landedDetected() {
-    return (fabs(currentVerticalVelocity()) < LANDED_VZ_MPS &&
-            currentAltitude() < LANDED_ALT_M);
+    // Same decision as the flight state machine (windowed stillness + impact).
+    return isLandingConfirmed();
 }
 
 // ================= LATERAL (C8) + VERTICAL (C7) =================
@@ -313,15 +269,15 @@ static float lateralTurnCommandDeg(float bearingToTargetDeg,
 
 static float verticalSymmetricBrakeDeltaDeg(float dtSec) {
     float vz = currentVerticalVelocity();
-    vzFiltered = VZ_LPF_ALPHA * vz + (1.0f - VZ_LPF_ALPHA) * vzFiltered;
+    vzFiltered = param(PRM_VZ_LPF_ALPHA) * vz + (1.0f - param(PRM_VZ_LPF_ALPHA)) * vzFiltered;
 
     // e > 0: measured vz above target (e.g. -2 > -5) => descending too slowly => add brake
-    float e = vzFiltered - VZ_CMD_MPS;
+    float e = vzFiltered - param(PRM_VZ_CMD_MPS);
     vzIntegral += e * dtSec;
-    vzIntegral = clampf(vzIntegral, -VZ_INT_MAX, VZ_INT_MAX);
+    vzIntegral = clampf(vzIntegral, -param(PRM_VZ_INT_MAX), param(PRM_VZ_INT_MAX));
 
-    float delta = VZ_KP * e + VZ_KI * vzIntegral;
-    return clampf(delta, -VZ_DELTA_CLAMP, VZ_DELTA_CLAMP);
+    float delta = param(PRM_VZ_KP) * e + param(PRM_VZ_KI) * vzIntegral;
+    return clampf(delta, -param(PRM_VZ_DELTA_CLAMP), param(PRM_VZ_DELTA_CLAMP));
 }
 
 // ================= STAGE DECISION LOGIC =================
@@ -331,23 +287,23 @@ static DescentStage determineDescentStage(float h_agl, float d_target, uint32_t
         return LANDED_MODE;
     }
 
-    if ((now - probeReleaseMs) < STABILIZE_TIME_MS) {
+    if ((now - probeReleaseMs) < paramU32(PRM_STABILIZE_TIME_MS)) {
         return DEPLOY_STABILIZE;
     }
 
-    if (h_agl <= RELEASE_ZONE_ALT_M) {
+    if (h_agl <= param(PRM_RELEASE_ZONE_ALT_M)) {
         return RELEASE_ZONE;
     }
 
-    if (h_agl <= FINAL_APPROACH_ALT_M) {
+    if (h_agl <= param(PRM_FINAL_APPROACH_ALT_M)) {
         return FINAL_APPROACH;
     }
 
-    if (d_target <= SPIRAL_DISTANCE_M) {
+    if (d_target <= param(PRM_SPIRAL_DISTANCE_M)) {
         return SPIRAL_ENERGY_MANAGEMENT;
     }
 
-    if (d_target <= FAR_DISTANCE_M) {
+    if (d_target <= param(PRM_FAR_DISTANCE_M)) {
         return MID_APPROACH;
     }
 
@@ -467,7 +423,7 @@ void updateParagliderControl() {
 
     DescentStage desiredStage = determineDescentStage(h_agl, d_target, now);
 
-    if (desiredStage != descentStage && (now - stageEntryMs) >= MIN_STAGE_DWELL_MS) {
+    if (desiredStage != descentStage && (now - stageEntryMs) >= paramU32(PRM_MIN_STAGE_DWELL_MS)) {
         enterDescentStage(desiredStage);
     }
 
@@ -480,9 +436,9 @@ void updateParagliderControl() {
             float vzTrim = verticalSymmetricBrakeDeltaDeg(paragliderDtSec);
             float sym = clampf(SYM_BRAKE_NONE + vzTrim, 0.0f, SERVO_MAX_ANGLE - SERVO_CENTER);
             float turnCmd = lateralTurnCommandDeg(desiredBearing,
-                                                  HEADING_KP_FAR,
-                                                  BASE_TURN_FAR,
-                                                  GYRO_DAMP_GAIN_FAR,
+                                                  param(PRM_HEADING_KP_FAR),
+                                                  param(PRM_BASE_TURN_FAR),
+                                                  param(PRM_GYRO_DAMP_GAIN_FAR),
                                                   maxTurn);
             applyBrakeAndTurn(sym, turnCmd);
             break;
@@ -492,9 +448,9 @@ void updateParagliderControl() {
             float vzTrim = verticalSymmetricBrakeDeltaDeg(paragliderDtSec);
             float sym = clampf(SYM_BRAKE_NONE + vzTrim, 0.0f, SERVO_MAX_ANGLE - SERVO_CENTER);
             float turnCmd = lateralTurnCommandDeg(desiredBearing,
-                                                  HEADING_KP_MID,
-                                                  BASE_TURN_MID,
-                                                  GYRO_DAMP_GAIN_MID,
+                                                  param(PRM_HEADING_KP_MID),
+                                                  param(PRM_BASE_TURN_MID),
+                                                  param(PRM_GYRO_DAMP_GAIN_MID),
                                                   maxTurn);
             applyBrakeAndTurn(sym, turnCmd);
             break;
@@ -502,15 +458,15 @@ void updateParagliderControl() {
 
         case SPIRAL_ENERGY_MANAGEMENT: {
             float vzTrim = verticalSymmetricBrakeDeltaDeg(paragliderDtSec);
-            float sym = clampf(SYM_BRAKE_SPIRAL + vzTrim, 0.0f, SERVO_MAX_ANGLE - SERVO_CENTER);
+            float sym = clampf(param(PRM_SYM_BRAKE_SPIRAL) + vzTrim, 0.0f, SERVO_MAX_ANGLE - SERVO_CENTER);
             float turnCmd = lateralTurnCommandDeg(desiredBearing,
-                                                  HEADING_KP_SPIRAL,
-                                                  BASE_TURN_SPIRAL,
-                                                  GYRO_DAMP_GAIN_MID,
+                                                  param(PRM_HEADING_KP_SPIRAL),
+                                                  param(PRM_BASE_TURN_SPIRAL),
+                                                  param(PRM_GYRO_DAMP_GAIN_MID),
                                                   maxTurn);
             applyBrakeAndTurn(sym, turnCmd);
 
-            if ((now - spiralEntryMs) > MAX_SPIRAL_TIME_MS && d_target > SPIRAL_DISTANCE_M) {
+            if ((now - spiralEntryMs) > paramU32(PRM_MAX_SPIRAL_TIME_MS) && d_target > param(PRM_SPIRAL_DISTANCE_M)) {
                 enterDescentStage(MID_APPROACH);
             }
             break;
@@ -518,27 +474,27 @@ void updateParagliderControl() {
 
         case FINAL_APPROACH: {
             float vzTrim = verticalSymmetricBrakeDeltaDeg(paragliderDtSec);
-            float sym = clampf(SYM_BRAKE_FINAL + vzTrim, 0.0f, SERVO_MAX_ANGLE - SERVO_CENTER);
+            float sym = clampf(param(PRM_SYM_BRAKE_FINAL) + vzTrim, 0.0f, SERVO_MAX_ANGLE - SERVO_CENTER);
             float turnCmd = lateralTurnCommandDeg(desiredBearing,
-                                                  HEADING_KP_FINAL,
-                                                  BASE_TURN_FINAL,
-                                                  GYRO_DAMP_GAIN_FINAL,
+                                                  param(PRM_HEADING_KP_FINAL),
+                                                  param(PRM_BASE_TURN_FINAL),
+                                                  param(PRM_GYRO_DAMP_GAIN_FINAL),
                                                   maxTurn);
             applyBrakeAndTurn(sym, turnCmd);
             break;
         }
 
         case RELEASE_ZONE: {
-            if (!payloadReleased && h_agl <= EGG_RELEASE_ALT_M) {
+            if (!payloadReleased && h_agl <= param(PRM_EGG_RELEASE_ALT_M)) {
                 releasePayload();
             }
 
             float vzTrim = verticalSymmetricBrakeDeltaDeg(paragliderDtSec);
-            float sym = clampf(SYM_BRAKE_RELEASE + vzTrim, 0.0f, SERVO_MAX_ANGLE - SERVO_CENTER);
+            float sym = clampf(param(PRM_SYM_BRAKE_RELEASE) + vzTrim, 0.0f, SERVO_MAX_ANGLE - SERVO_CENTER);
             float turnCmd = lateralTurnCommandDeg(desiredBearing,
-                                                  HEADING_KP_RELEASE,
-                                                  BASE_TURN_FINAL * 0.6f,
-                                                  GYRO_DAMP_GAIN_FINAL,
+                                                  param(PRM_HEADING_KP_RELEASE),
+                                                  param(PRM_BASE_TURN_FINAL) * 0.6f,
+                                                  param(PRM_GYRO_DAMP_GAIN_FINAL),
                                                   maxTurn);
             applyBrakeAndTurn(sym, turnCmd);
             break;
@@ -0,0 +1,314 @@
+// Reference codec for the binary telemetry side stream (see BinaryFrame.h).
+// Deliberately free of Arduino includes so the GCS can build it on a host.
+#include "BinaryFrame.h"
+#include <string.h>
+
+uint16_t crc16Ccitt(const uint8_t* data, size_t len, uint16_t crc) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out, size_t outCap) {
+    if (outCap < len + len / 254 + 1) return 0;
+
+    size_t codeIdx = 0;  // Where the current block's code byte goes
+    size_t o = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[codeIdx] = code;
+            codeIdx = o++;
+            code = 1;
+        } else {
+            out[o++] = in[i];
+            if (++code == 0xFF) {
+                out[codeIdx] = code;
+                codeIdx = o++;
+                code = 1;
+            }
+        }
+    }
+    out[codeIdx] = code;
+    return o;
+}
+
+size_t cobsDecode(const uint8_t* in, size_t len, uint8_t* out, size_t outCap) {
+    size_t i = 0;
+    size_t o = 0;
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > len) return 0;
+        for (uint8_t k = 1; k < code; k++) {
+            if (o >= outCap || in[i] == 0) return 0;
+            out[o++] = in[i++];
+        }
+        if (code != 0xFF && i < len) {
+            if (o >= outCap) return 0;
+            out[o++] = 0;
+        }
+    }
+    return o;
+}
+
+size_t binEncodeFrame(uint8_t type, const uint8_t* body, size_t bodyLen,
+                      uint8_t* out, size_t outCap) {
+    if (bodyLen > BIN_MAX_BODY || outCap < 3) return 0;
+
+    uint8_t raw[BIN_MAX_RAW];
+    raw[0] = type;
+    raw[1] = BIN_FRAME_VERSION;
+    if (bodyLen > 0) memcpy(raw + 2, body, bodyLen);
+    uint16_t crc = crc16Ccitt(raw, bodyLen + 2);
+    binPutU16(raw + 2 + bodyLen, crc);
+
+    out[0] = 0x00;
+    size_t n = cobsEncode(raw, bodyLen + 4, out + 1, outCap - 2);
+    if (n == 0) return 0;
+    out[1 + n] = 0x00;
+    return n + 2;
+}
+
+size_t binDecodeFrame(const uint8_t* cobsBytes, size_t len, uint8_t* type,
+                      uint8_t* bodyOut, size_t bodyCap) {
+    uint8_t raw[BIN_MAX_RAW];
+    size_t n = cobsDecode(cobsBytes, len, raw, sizeof(raw));
+    if (n < 5) return 0;  // type + version + at least one body byte + CRC
+
+    uint16_t crc = binGetU16(raw + n - 2);
+    if (crc16Ccitt(raw, n - 2) != crc) return 0;
+    if (raw[1] != BIN_FRAME_VERSION) return 0;
+
+    size_t bodyLen = n - 4;
+    if (bodyLen > bodyCap) return 0;
+    if (type != nullptr) *type = raw[0];
+    memcpy(bodyOut, raw + 2, bodyLen);
+    return bodyLen;
+}
+
+void binPutU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+void binPutU32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+uint16_t binGetU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint32_t binGetU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+size_t binPackSample(const BinSample& s, uint8_t* body) {
+    uint8_t* p = body;
+    binPutU16(p, s.seq);                          p += 2;
+    binPutU32(p, s.captureMs);                    p += 4;
+    *p++ = s.state;
+    *p++ = s.gpsSats;
+    binPutU32(p, (uint32_t)s.altitudeDm);         p += 4;
+    binPutU16(p, s.pressureDaPa);                 p += 2;
+    binPutU16(p, (uint16_t)s.temperatureDc);      p += 2;
+    binPutU16(p, s.voltageMv);                    p += 2;
+    binPutU16(p, (uint16_t)s.currentMa);          p += 2;
+    for (int i = 0; i < 3; i++) {
+        binPutU16(p, (uint16_t)s.gyroDds[i]);     p += 2;
+    }
+    for (int i = 0; i < 3; i++) {
+        binPutU16(p, (uint16_t)s.accelCms2[i]);   p += 2;
+    }
+    binPutU32(p, (uint32_t)s.gpsLatE7);           p += 4;
+    binPutU32(p, (uint32_t)s.gpsLonE7);           p += 4;
+    binPutU32(p, (uint32_t)s.gpsAltDm);           p += 4;
+    binPutU16(p, (uint16_t)s.vertVelCms);         p += 2;
+    return (size_t)(p - body);
+}
+
+bool binUnpackSample(const uint8_t* body, size_t len, BinSample* out) {
+    if (body == nullptr || out == nullptr || len < BIN_SAMPLE_BODY_SIZE) return false;
+
+    const uint8_t* p = body;
+    out->seq = binGetU16(p);                          p += 2;
+    out->captureMs = binGetU32(p);                    p += 4;
+    out->state = *p++;
+    out->gpsSats = *p++;
+    out->altitudeDm = (int32_t)binGetU32(p);          p += 4;
+    out->pressureDaPa = binGetU16(p);                 p += 2;
+    out->temperatureDc = (int16_t)binGetU16(p);       p += 2;
+    out->voltageMv = binGetU16(p);                    p += 2;
+    out->currentMa = (int16_t)binGetU16(p);           p += 2;
+    for (int i = 0; i < 3; i++) {
+        out->gyroDds[i] = (int16_t)binGetU16(p);      p += 2;
+    }
+    for (int i = 0; i < 3; i++) {
+        out->accelCms2[i] = (int16_t)binGetU16(p);    p += 2;
+    }
+    out->gpsLatE7 = (int32_t)binGetU32(p);            p += 4;
+    out->gpsLonE7 = (int32_t)binGetU32(p);            p += 4;
+    out->gpsAltDm = (int32_t)binGetU32(p);            p += 4;
+    out->vertVelCms = (int16_t)binGetU16(p);          p += 2;
+    return true;
+}
+
+size_t binPutVarint(uint8_t* p, int32_t v) {
+    uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);  // Zigzag: small |v| -> small z
+    size_t n = 0;
+    while (z >= 0x80) {
+        p[n++] = (uint8_t)(z | 0x80);
+        z >>= 7;
+    }
+    p[n++] = (uint8_t)z;
+    return n;
+}
+
+size_t binGetVarint(const uint8_t* p, size_t len, int32_t* v) {
+    uint32_t z = 0;
+    for (size_t n = 0; n < len && n < 5; n++) {
+        z |= (uint32_t)(p[n] & 0x7F) << (7 * n);
+        if ((p[n] & 0x80) == 0) {
+            *v = (int32_t)((z >> 1) ^ (~(z & 1) + 1));
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+// Delta-coded fields of a BinSample, in declaration order (after seq).
+static const int BIN_DELTA_FIELDS = (int)BIN_DELTA_FIELD_COUNT;
+
+static void sampleToFields(const BinSample& s, int32_t* f) {
+    f[0] = (int32_t)s.captureMs;
+    f[1] = s.state;
+    f[2] = s.gpsSats;
+    f[3] = s.altitudeDm;
+    f[4] = s.pressureDaPa;
+    f[5] = s.temperatureDc;
+    f[6] = s.voltageMv;
+    f[7] = s.currentMa;
+    f[8] = s.gyroDds[0];
+    f[9] = s.gyroDds[1];
+    f[10] = s.gyroDds[2];
+    f[11] = s.accelCms2[0];
+    f[12] = s.accelCms2[1];
+    f[13] = s.accelCms2[2];
+    f[14] = s.gpsLatE7;
+    f[15] = s.gpsLonE7;
+    f[16] = s.gpsAltDm;
+    f[17] = s.vertVelCms;
+}
+
+static void fieldsToSample(const int32_t* f, BinSample* s) {
+    s->captureMs = (uint32_t)f[0];
+    s->state = (uint8_t)f[1];
+    s->gpsSats = (uint8_t)f[2];
+    s->altitudeDm = f[3];
+    s->pressureDaPa = (uint16_t)f[4];
+    s->temperatureDc = (int16_t)f[5];
+    s->voltageMv = (uint16_t)f[6];
+    s->currentMa = (int16_t)f[7];
+    s->gyroDds[0] = (int16_t)f[8];
+    s->gyroDds[1] = (int16_t)f[9];
+    s->gyroDds[2] = (int16_t)f[10];
+    s->accelCms2[0] = (int16_t)f[11];
+    s->accelCms2[1] = (int16_t)f[12];
+    s->accelCms2[2] = (int16_t)f[13];
+    s->gpsLatE7 = f[14];
+    s->gpsLonE7 = f[15];
+    s->gpsAltDm = f[16];
+    s->vertVelCms = (int16_t)f[17];
+}
+
+size_t binPackDelta(const BinSample& prev, const BinSample& cur, uint8_t* body, size_t cap) {
+    if (cap < BIN_DELTA_MAX_BODY) return 0;
+
+    int32_t a[BIN_DELTA_FIELDS];
+    int32_t b[BIN_DELTA_FIELDS];
+    sampleToFields(prev, a);
+    sampleToFields(cur, b);
+
+    size_t n = 0;
+    binPutU16(body, cur.seq);
+    n += 2;
+    for (int i = 0; i < BIN_DELTA_FIELDS; i++) {
+        // Wrapping 32-bit difference: exact for every field, including capture_ms.
+        n += binPutVarint(body + n, (int32_t)((uint32_t)b[i] - (uint32_t)a[i]));
+    }
+    return n;
+}
+
+bool binUnpackDelta(const BinSample& prev, const uint8_t* body, size_t len, BinSample* out) {
+    if (body == nullptr || out == nullptr || len < 2) return false;
+
+    int32_t f[BIN_DELTA_FIELDS];
+    sampleToFields(prev, f);
+    size_t n = 2;
+    for (int i = 0; i < BIN_DELTA_FIELDS; i++) {
+        int32_t d;
+        size_t used = binGetVarint(body + n, len - n, &d);
+        if (used == 0) return false;
+        n += used;
+        f[i] = (int32_t)((uint32_t)f[i] + (uint32_t)d);
+    }
+    fieldsToSample(f, out);
+    out->seq = binGetU16(body);
+    return true;
+}
+
+void binDecoderReset(BinStreamDecoder* dec) {
+    memset(&dec->last, 0, sizeof(dec->last));
+    dec->valid = false;
+}
+
+bool binDecoderFeed(BinStreamDecoder* dec, uint8_t type, const uint8_t* body, size_t len,
+                    BinSample* out) {
+    BinSample s;
+    if (type == BIN_FRAME_SAMPLE) {
+        if (!binUnpackSample(body, len, &s)) return false;
+    } else if (type == BIN_FRAME_DELTA) {
+        // Only valid on top of the immediately preceding frame.
+        if (!dec->valid || len < 2 || binGetU16(body) != (uint16_t)(dec->last.seq + 1)) {
+            dec->valid = false;
+            return false;
+        }
+        if (!binUnpackDelta(dec->last, body, len, &s)) {
+            dec->valid = false;
+            return false;
+        }
+    } else {
+        return false;  // Not a sample-stream frame
+    }
+
+    dec->last = s;
+    dec->valid = true;
+    if (out != nullptr) *out = s;
+    return true;
+}
+
+size_t binPackStateEvent(const BinStateEvent& e, uint8_t* body) {
+    body[0] = e.burstId;
+    body[1] = e.fromState;
+    body[2] = e.toState;
+    binPutU32(body + 3, e.transitionMs);
+    binPutU32(body + 7, e.missionMs);
+    return BIN_STATE_BODY_SIZE;
+}
+
+bool binUnpackStateEvent(const uint8_t* body, size_t len, BinStateEvent* out) {
+    if (body == nullptr || out == nullptr || len < BIN_STATE_BODY_SIZE) return false;
+    out->burstId = body[0];
+    out->fromState = body[1];
+    out->toState = body[2];
+    out->transitionMs = binGetU32(body + 3);
+    out->missionMs = binGetU32(body + 7);
+    return true;
+}
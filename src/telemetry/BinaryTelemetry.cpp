@@ -0,0 +1,130 @@
+// High-rate binary telemetry side stream: snapshot -> BinSample -> COBS frame -> LINK_STREAM.
+#include "BinaryTelemetry.h"
+#include "FlightState.h"
+#include "LinkScheduler.h"
+#include "Sensors.h"
+#include <Arduino.h>
+#include <math.h>
+#include <string.h>
+
+static bool binEnabled = false;
+static uint32_t binPeriodMs = 1000 / BIN_RATE_DEFAULT_HZ;
+static uint32_t lastBinFrameMs = 0;
+static uint16_t binSeq = 0;
+static bool binDelta = false;
+static bool needKeyframe = true;   // Next frame must be a full sample
+static uint8_t framesSinceKey = 0;
+static BinSample lastSentSample;   // Reference for the next delta frame
+static BinTelemetryStats binStats;
+
+// Cycle counter for encode cost (Teensy 4.x DWT; micros() elsewhere).
+static inline uint32_t encodeClock() {
+#ifdef ARM_DWT_CYCCNT
+    return ARM_DWT_CYCCNT;
+#else
+    return micros();
+#endif
+}
+
+// Round and saturate to the target integer range (out-of-range values pin to the limit).
+static int32_t scaleClamp(float v, float scale, int32_t lo, int32_t hi) {
+    if (!isfinite(v)) return 0;
+    float x = roundf(v * scale);
+    if (x <= (float)lo) return lo;
+    if (x >= (float)hi) return hi;
+    return (int32_t)x;
+}
+
+void initBinaryTelemetry() {
+    binEnabled = false;
+    binPeriodMs = 1000 / BIN_RATE_DEFAULT_HZ;
+    lastBinFrameMs = 0;
+    binSeq = 0;
+    binDelta = false;
+    needKeyframe = true;
+    memset(&binStats, 0, sizeof(binStats));
+}
+
+void setBinaryTelemetry(bool enabled, uint8_t rateHz, bool delta) {
+    if (rateHz < BIN_RATE_MIN_HZ) rateHz = BIN_RATE_MIN_HZ;
+    if (rateHz > BIN_RATE_MAX_HZ) rateHz = BIN_RATE_MAX_HZ;
+    binPeriodMs = 1000 / rateHz;
+    if (enabled && !binEnabled) {
+        memset(&binStats, 0, sizeof(binStats));
+    }
+    binEnabled = enabled;
+    binDelta = delta;
+    needKeyframe = true;
+}
+
+void getBinaryTelemetryStats(BinTelemetryStats* out) {
+    if (out != nullptr) *out = binStats;
+}
+
+bool isBinaryTelemetryEnabled() {
+    return binEnabled;
+}
+
+void binSampleFromSnapshot(const SensorSnapshot& snap, uint8_t state, BinSample* out) {
+    out->seq = 0;
+    out->captureMs = snap.captureMs;
+    out->state = state;
+    out->gpsSats = snap.gpsSatellites;
+    out->altitudeDm = scaleClamp(snap.altitude, 10.0f, INT32_MIN, INT32_MAX);
+    out->pressureDaPa = (uint16_t)scaleClamp(snap.pressure, 100.0f, 0, UINT16_MAX);
+    out->temperatureDc = (int16_t)scaleClamp(snap.temperature, 10.0f, INT16_MIN, INT16_MAX);
+    out->voltageMv = (uint16_t)scaleClamp(snap.voltage, 1000.0f, 0, UINT16_MAX);
+    out->currentMa = (int16_t)scaleClamp(snap.current, 1000.0f, INT16_MIN, INT16_MAX);
+    out->gyroDds[0] = (int16_t)scaleClamp(snap.gyroR, 10.0f, INT16_MIN, INT16_MAX);
+    out->gyroDds[1] = (int16_t)scaleClamp(snap.gyroP, 10.0f, INT16_MIN, INT16_MAX);
+    out->gyroDds[2] = (int16_t)scaleClamp(snap.gyroY, 10.0f, INT16_MIN, INT16_MAX);
+    out->accelCms2[0] = (int16_t)scaleClamp(snap.accelR, 100.0f, INT16_MIN, INT16_MAX);
+    out->accelCms2[1] = (int16_t)scaleClamp(snap.accelP, 100.0f, INT16_MIN, INT16_MAX);
+    out->accelCms2[2] = (int16_t)scaleClamp(snap.accelY, 100.0f, INT16_MIN, INT16_MAX);
+    // 1e-7 deg exceeds float precision; go through double so the scaling adds no error.
+    out->gpsLatE7 = (int32_t)lround((double)snap.gpsLatitude * 1e7);
+    out->gpsLonE7 = (int32_t)lround((double)snap.gpsLongitude * 1e7);
+    out->gpsAltDm = scaleClamp(snap.gpsAltitude, 10.0f, INT32_MIN, INT32_MAX);
+    out->vertVelCms = (int16_t)scaleClamp(snap.verticalVelocity, 100.0f, INT16_MIN, INT16_MAX);
+}
+
+void updateBinaryTelemetry(uint32_t now_ms) {
+    if (!binEnabled) return;
+    if (now_ms - lastBinFrameMs < binPeriodMs) return;
+    lastBinFrameMs = now_ms;
+
+    uint32_t t0 = encodeClock();
+    SensorSnapshot snap;
+    captureSensorSnapshot(&snap);
+    BinSample sample;
+    binSampleFromSnapshot(snap, (uint8_t)flightState, &sample);
+    sample.seq = binSeq++;  // Advances even if dropped, so the GCS can count losses
+
+    bool keyframe = !binDelta || needKeyframe || framesSinceKey >= BIN_KEYFRAME_INTERVAL;
+    uint8_t body[BIN_DELTA_MAX_BODY > BIN_SAMPLE_BODY_SIZE ? BIN_DELTA_MAX_BODY : BIN_SAMPLE_BODY_SIZE];
+    size_t bodyLen = keyframe ? binPackSample(sample, body)
+                              : binPackDelta(lastSentSample, sample, body, sizeof(body));
+    uint8_t wire[BIN_MAX_WIRE];
+    size_t wireLen = binEncodeFrame(keyframe ? BIN_FRAME_SAMPLE : BIN_FRAME_DELTA,
+                                    body, bodyLen, wire, sizeof(wire));
+    uint32_t cycles = encodeClock() - t0;
+    binStats.lastEncodeCycles = cycles;
+    if (cycles > binStats.maxEncodeCycles) binStats.maxEncodeCycles = cycles;
+    if (wireLen == 0) return;
+
+    if (linkSubmit(LINK_STREAM, wire, wireLen)) {
+        binStats.framesSent++;
+        binStats.wireBytes += wireLen;
+        if (keyframe) {
+            binStats.keyframes++;
+            framesSinceKey = 0;
+        }
+        framesSinceKey++;
+        lastSentSample = sample;
+        needKeyframe = false;
+    } else {
+        // The ground never sees this frame, so a delta against it would be undecodable.
+        binStats.framesDropped++;
+        needKeyframe = true;
+    }
+}
@@ -0,0 +1,169 @@
+// Burst telemetry around flight-state transitions (see BurstTelemetry.h).
+//
+// Only one burst is in flight at a time. A transition that happens while the
+// current burst is still collecting its post window (e.g. APOGEE -> DESCENT one
+// tick after ASCENT -> APOGEE) is covered by that window and only gets its event
+// frame; a transition while a finished burst is still being sent is counted in
+// burstsSkipped.
+#include "BurstTelemetry.h"
+#include "BinaryFrame.h"
+#include "BinaryTelemetry.h"
+#include "FlightLog.h"
+#include "BlackBox.h"
+#include "LinkScheduler.h"
+#include "Sensors.h"
+#include "Timing.h"
+#include <Arduino.h>
+#include <string.h>
+
+static const uint8_t HISTORY_SIZE = 32;  // Power of two >= BURST_PRE_SAMPLES
+static const uint8_t BURST_CAPACITY = BURST_PRE_SAMPLES + BURST_POST_SAMPLES;
+
+static bool burstEnabled = true;
+
+// Continuous 20 Hz history
+static BinSample history[HISTORY_SIZE];
+static uint8_t historyHead = 0;
+static uint8_t historyCount = 0;
+static uint32_t lastHistoryMs = 0;
+
+// Active burst: samples[0 .. preCount-1] precede the transition, the rest follow.
+static bool burstActive = false;
+static uint8_t burstId = 0;
+static BinSample burstSamples[BURST_CAPACITY];
+static uint8_t burstPreCount = 0;
+static uint8_t burstCount = 0;     // Samples collected so far
+static uint8_t burstSentCount = 0; // Samples already transmitted
+
+static BurstStats burstStats;
+
+void initBurstTelemetry() {
+    burstEnabled = true;
+    historyHead = 0;
+    historyCount = 0;
+    lastHistoryMs = 0;
+    burstActive = false;
+    burstId = 0;
+    memset(&burstStats, 0, sizeof(burstStats));
+}
+
+void setBurstTelemetryEnabled(bool enabled) {
+    burstEnabled = enabled;
+    if (!enabled) burstActive = false;
+}
+
+bool isBurstTelemetryEnabled() {
+    return burstEnabled;
+}
+
+void getBurstStats(BurstStats* out) {
+    if (out != nullptr) *out = burstStats;
+}
+
+static void sendStateEvent(FlightState from, FlightState to) {
+    BinStateEvent e;
+    e.burstId = burstId;
+    e.fromState = (uint8_t)from;
+    e.toState = (uint8_t)to;
+    e.transitionMs = millis();
+    if (!getMissionTimeMs(e.missionMs)) {
+        e.missionMs = 0xFFFFFFFFUL;
+    }
+
+    uint8_t body[BIN_STATE_BODY_SIZE];
+    size_t bodyLen = binPackStateEvent(e, body);
+    flightLogFrame(BIN_FRAME_STATE, body, bodyLen);
+    blackBoxFrame(BIN_FRAME_STATE, body, bodyLen);
+
+    uint8_t wire[BIN_MAX_WIRE];
+    size_t wireLen = binEncodeFrame(BIN_FRAME_STATE, body, bodyLen, wire, sizeof(wire));
+    if (wireLen == 0 || !linkSubmit(LINK_ACK, wire, wireLen)) {
+        burstStats.eventsDropped++;
+    }
+}
+
+void onFlightStateTransition(FlightState from, FlightState to) {
+    burstStats.transitions++;
+    bool collecting = burstActive && burstCount < BURST_CAPACITY;
+
+    if (!collecting) {
+        burstId++;
+    }
+    sendStateEvent(from, to);
+
+    if (!burstEnabled || collecting) {
+        return;  // Covered by the running post window (see file header)
+    }
+    if (burstActive) {
+        burstStats.burstsSkipped++;
+        return;
+    }
+
+    // Freeze the pre-transition window (oldest first).
+    uint8_t pre = historyCount < BURST_PRE_SAMPLES ? historyCount : BURST_PRE_SAMPLES;
+    for (uint8_t i = 0; i < pre; i++) {
+        uint8_t idx = (uint8_t)(historyHead - pre + i) & (HISTORY_SIZE - 1);
+        burstSamples[i] = history[idx];
+        burstSamples[i].seq = (uint16_t)(int16_t)(i - pre);
+    }
+    burstPreCount = pre;
+    burstCount = pre;
+    burstSentCount = 0;
+    burstActive = true;
+}
+
+// Send as many whole samples as the burst class has airtime for, in one chunk.
+static void sendPendingChunk() {
+    uint8_t ready = burstCount - burstSentCount;
+    if (ready == 0) return;
+
+    size_t avail = linkAvailableBytes(LINK_BURST);
+    const size_t overhead = 2 + 2 + 2 + BIN_BURST_HEADER_SIZE + 2;  // delimiters, type/ver, CRC, COBS
+    if (avail <= overhead + BIN_SAMPLE_BODY_SIZE) return;
+    size_t fit = (avail - overhead) / BIN_SAMPLE_BODY_SIZE;
+    uint8_t n = ready;
+    if (n > fit) n = (uint8_t)fit;
+    if (n > BIN_BURST_MAX_SAMPLES) n = BIN_BURST_MAX_SAMPLES;
+
+    uint8_t body[BIN_MAX_BODY];
+    body[0] = burstId;
+    body[1] = (uint8_t)(int8_t)(burstSentCount - burstPreCount);
+    body[2] = n;
+    size_t len = BIN_BURST_HEADER_SIZE;
+    for (uint8_t i = 0; i < n; i++) {
+        len += binPackSample(burstSamples[burstSentCount + i], body + len);
+    }
+
+    uint8_t wire[BIN_MAX_WIRE];
+    size_t wireLen = binEncodeFrame(BIN_FRAME_BURST, body, len, wire, sizeof(wire));
+    if (wireLen > 0 && linkSubmit(LINK_BURST, wire, wireLen)) {
+        burstSentCount += n;
+        burstStats.samplesSent += n;
+    }
+}
+
+void updateBurstTelemetry(uint32_t now_ms) {
+    if (now_ms - lastHistoryMs >= BURST_SAMPLE_PERIOD_MS) {
+        lastHistoryMs = now_ms;
+
+        SensorSnapshot snap;
+        captureSensorSnapshot(&snap);
+        BinSample sample;
+        binSampleFromSnapshot(snap, (uint8_t)flightState, &sample);
+
+        history[historyHead] = sample;
+        historyHead = (historyHead + 1) & (HISTORY_SIZE - 1);
+        if (historyCount < HISTORY_SIZE) historyCount++;
+
+        if (burstActive && burstCount < BURST_CAPACITY) {
+            sample.seq = (uint16_t)(burstCount - burstPreCount);
+            burstSamples[burstCount++] = sample;
+        }
+    }
+
+    if (!burstActive) return;
+    sendPendingChunk();
+    if (burstCount == BURST_CAPACITY && burstSentCount == burstCount) {
+        burstActive = false;
+    }
+}
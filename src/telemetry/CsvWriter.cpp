@@ -0,0 +1,142 @@
+// CSV field writer used by sendTelemetry(); replaces newlib "%f" formatting.
+//
+// Exactness: a float has a 24-bit significand and 10^6 needs 20 bits, so the
+// product v * 10^decimals is exact in a double. floor() and the half-way compare
+// are then exact too, which is what makes the output match printf digit for digit.
+#include "CsvWriter.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static const uint32_t POW10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+
+static void putRaw(CsvWriter* w, const char* s, size_t n) {
+    if (w->overflow || w->len + n >= w->cap) {  // Keep room for the NUL
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+}
+
+static void beginField(CsvWriter* w) {
+    if (w->fields++ > 0) {
+        putRaw(w, ",", 1);
+    }
+}
+
+// Digits of v, least significant first into tmp; returns count (at least minDigits).
+static size_t formatDigits(uint64_t v, uint8_t minDigits, char* tmp) {
+    size_t n = 0;
+    do {
+        tmp[n++] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v > 0);
+    while (n < minDigits) {
+        tmp[n++] = '0';
+    }
+    return n;
+}
+
+static void putDigitsReversed(CsvWriter* w, const char* tmp, size_t n) {
+    char out[24];
+    for (size_t i = 0; i < n; i++) {
+        out[i] = tmp[n - 1 - i];
+    }
+    putRaw(w, out, n);
+}
+
+void csvBegin(CsvWriter* w, char* buf, size_t cap) {
+    w->buf = buf;
+    w->cap = cap;
+    w->len = 0;
+    w->fields = 0;
+    w->overflow = (buf == nullptr || cap == 0);
+}
+
+void csvPutStr(CsvWriter* w, const char* s) {
+    beginField(w);
+    if (s != nullptr) {
+        putRaw(w, s, strlen(s));
+    }
+}
+
+void csvPutChar(CsvWriter* w, char c) {
+    beginField(w);
+    putRaw(w, &c, 1);
+}
+
+void csvPutUInt(CsvWriter* w, uint32_t v, uint8_t minDigits) {
+    beginField(w);
+    char tmp[24];
+    putDigitsReversed(w, tmp, formatDigits(v, minDigits, tmp));
+}
+
+void csvPutFixed(CsvWriter* w, float v, uint8_t decimals) {
+    beginField(w);
+    if (decimals > 6) decimals = 6;
+
+    if (isnan(v)) {
+        putRaw(w, "nan", 3);
+        return;
+    }
+    bool negative = signbit(v);
+    if (negative) {
+        putRaw(w, "-", 1);
+    }
+    if (isinf(v)) {
+        putRaw(w, "inf", 3);
+        return;
+    }
+
+    double scaled = fabs((double)v) * POW10[decimals];  // Exact (see file header)
+    if (scaled >= 9.0e18) {
+        // Beyond uint64 range: never happens for sensor data, but stay correct.
+        char tmp[64];
+        int n = snprintf(tmp, sizeof(tmp), "%.*f", decimals, fabs((double)v));
+        if (n > 0) putRaw(w, tmp, (size_t)n);
+        return;
+    }
+
+    double whole = floor(scaled);
+    double frac = scaled - whole;
+    uint64_t q = (uint64_t)whole;
+    if (frac > 0.5 || (frac == 0.5 && (q & 1u))) {
+        q++;  // Round half to even, as printf does on the exact value
+    }
+
+    // q holds the value in units of 10^-decimals: emit integer part, '.', fraction.
+    char tmp[24];
+    size_t n = formatDigits(q, (uint8_t)(decimals + 1), tmp);
+    if (decimals == 0) {
+        putDigitsReversed(w, tmp, n);
+        return;
+    }
+    putDigitsReversed(w, tmp + decimals, n - decimals);
+    putRaw(w, ".", 1);
+    putDigitsReversed(w, tmp, decimals);
+}
+
+void csvPutTime(CsvWriter* w, uint8_t h, uint8_t m, uint8_t s) {
+    beginField(w);
+    char t[8] = {
+        (char)('0' + (h / 10) % 10), (char)('0' + h % 10), ':',
+        (char)('0' + m / 10 % 10),   (char)('0' + m % 10), ':',
+        (char)('0' + s / 10 % 10),   (char)('0' + s % 10)
+    };
+    putRaw(w, t, sizeof(t));
+}
+
+void csvPutEmpty(CsvWriter* w) {
+    beginField(w);
+}
+
+size_t csvEnd(CsvWriter* w) {
+    putRaw(w, "\r\n", 2);
+    if (w->overflow) {
+        if (w->buf != nullptr && w->cap > 0) w->buf[0] = '\0';
+        return 0;
+    }
+    w->buf[w->len] = '\0';
+    return w->len;
+}
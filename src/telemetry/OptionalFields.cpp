@@ -0,0 +1,95 @@
+// Static OPTIONAL_DATA table built from each module's <MODULE>_OPTIONAL_FIELDS list.
+#include "OptionalFields.h"
+#include "Sensors.h"
+#include "XBee.h"
+#include "TelemetryAggregate.h"
+#include "Commands.h"
+#include "Timing.h"
+#include "telemetry.h"
+
+// Column order on the wire. Append new module lists at the end so existing
+// GCS column indices stay stable.
+#define OPTIONAL_FIELD_LIST(FIXED, UINT) \
+    SENSORS_OPTIONAL_FIELDS(FIXED, UINT) \
+    XBEE_OPTIONAL_FIELDS(FIXED, UINT)    \
+    AGGREGATE_OPTIONAL_FIELDS(FIXED, UINT) \
+    COMMANDS_OPTIONAL_FIELDS(FIXED, UINT) \
+    TIMING_OPTIONAL_FIELDS(FIXED, UINT)  \
+    TELEMETRY_OPTIONAL_FIELDS(FIXED, UINT) \
+    SNAPSHOT_OPTIONAL_FIELDS(FIXED, UINT)
+
+#define OPT_FIXED_ENTRY(name, decimals, getter) { name, decimals, getter, nullptr },
+#define OPT_UINT_ENTRY(name, getter)            { name, 0, nullptr, getter },
+
+static constexpr OptionalField OPTIONAL_FIELDS[] = {
+    OPTIONAL_FIELD_LIST(OPT_FIXED_ENTRY, OPT_UINT_ENTRY)
+};
+
+static constexpr size_t OPTIONAL_FIELD_COUNT = sizeof(OPTIONAL_FIELDS) / sizeof(OPTIONAL_FIELDS[0]);
+
+// Compile-time checks: names must be non-empty CSV tokens and decimals within
+// what CsvWriter formats exactly.
+static constexpr bool validName(const char* s) {
+    if (s == nullptr || *s == '\0') return false;
+    for (; *s != '\0'; ++s) {
+        if (*s == ',' || *s == '\r' || *s == '\n' || *s == ' ') return false;
+    }
+    return true;
+}
+
+static constexpr bool sameName(const char* a, const char* b) {
+    while (*a != '\0' && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+static constexpr bool registryValid() {
+    for (size_t i = 0; i < OPTIONAL_FIELD_COUNT; i++) {
+        const OptionalField& f = OPTIONAL_FIELDS[i];
+        if (!validName(f.name) || f.decimals > 6) return false;
+        if ((f.getFixed == nullptr) == (f.getUInt == nullptr)) return false;
+        for (size_t j = 0; j < i; j++) {
+            if (sameName(f.name, OPTIONAL_FIELDS[j].name)) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(registryValid(), "OPTIONAL_DATA registry: bad or duplicate column name");
+
+size_t optionalFieldCount() {
+    return OPTIONAL_FIELD_COUNT;
+}
+
+const OptionalField* optionalFieldAt(size_t index) {
+    return (index < OPTIONAL_FIELD_COUNT) ? &OPTIONAL_FIELDS[index] : nullptr;
+}
+
+void writeOptionalFields(CsvWriter* w, const SensorSnapshot& snap) {
+    for (size_t i = 0; i < OPTIONAL_FIELD_COUNT; i++) {
+        const OptionalField& f = OPTIONAL_FIELDS[i];
+        if (f.getFixed != nullptr) {
+            float v;
+            if (f.getFixed(snap, &v)) {
+                csvPutFixed(w, v, f.decimals);
+            } else {
+                csvPutEmpty(w);
+            }
+        } else {
+            uint32_t v;
+            if (f.getUInt(snap, &v)) {
+                csvPutUInt(w, v);
+            } else {
+                csvPutEmpty(w);
+            }
+        }
+    }
+}
+
+void writeOptionalFieldNames(CsvWriter* w) {
+    for (size_t i = 0; i < OPTIONAL_FIELD_COUNT; i++) {
+        csvPutStr(w, OPTIONAL_FIELDS[i].name);
+    }
+}
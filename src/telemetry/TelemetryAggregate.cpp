@@ -0,0 +1,133 @@
+// Streaming per-window statistics for the AGG telemetry mode.
+// Welford's update keeps mean/variance numerically stable in float without storing
+// the ~100 samples of a window; min/max are tracked alongside.
+#include "TelemetryAggregate.h"
+#include "Sensors.h"
+#include "telemetry.h"
+#include <math.h>
+#include <string.h>
+
+struct Accumulator {
+    uint32_t n;
+    float mean;
+    float m2;  // Sum of squared deviations from the running mean
+    float min;
+    float max;
+};
+
+struct WindowResult {
+    float min;
+    float max;
+    float stddev;
+};
+
+static bool aggregateEnabled = false;
+static Accumulator acc[AGG_CHANNEL_COUNT];
+static WindowResult lastWindow[AGG_CHANNEL_COUNT];
+static uint32_t lastWindowSamples = 0;  // 0 = no closed window available
+
+static void resetAccumulators() {
+    memset(acc, 0, sizeof(acc));
+}
+
+static void accumulate(Accumulator& a, float x) {
+    if (a.n == 0) {
+        a.min = x;
+        a.max = x;
+    } else {
+        if (x < a.min) a.min = x;
+        if (x > a.max) a.max = x;
+    }
+    a.n++;
+    float delta = x - a.mean;
+    a.mean += delta / (float)a.n;
+    a.m2 += delta * (x - a.mean);
+}
+
+// Channel values of a snapshot, in AggChannel order.
+static float* channelPtr(SensorSnapshot* s, int ch) {
+    switch (ch) {
+        case AGG_ALTITUDE: return &s->altitude;
+        case AGG_GYRO_R:   return &s->gyroR;
+        case AGG_GYRO_P:   return &s->gyroP;
+        case AGG_GYRO_Y:   return &s->gyroY;
+        case AGG_ACCEL_R:  return &s->accelR;
+        case AGG_ACCEL_P:  return &s->accelP;
+        case AGG_ACCEL_Y:  return &s->accelY;
+        default:           return nullptr;
+    }
+}
+
+void initTelemetryAggregate() {
+    aggregateEnabled = false;
+    resetAccumulators();
+    lastWindowSamples = 0;
+}
+
+void setTelemetryAggregateEnabled(bool enabled) {
+    if (enabled != aggregateEnabled) {
+        // Start from a clean window so the first packet is not a partial mix.
+        resetAccumulators();
+        lastWindowSamples = 0;
+    }
+    aggregateEnabled = enabled;
+}
+
+bool isTelemetryAggregateEnabled() {
+    return aggregateEnabled;
+}
+
+void restartTelemetryAggregateWindow() {
+    resetAccumulators();
+    lastWindowSamples = 0;
+}
+
+void updateTelemetryAggregate() {
+    // Only packets close the window; with telemetry off nothing would ever reset it.
+    if (!aggregateEnabled || !isTelemetryEnabled()) return;
+
+    SensorSnapshot snap;
+    captureSensorSnapshot(&snap);
+    for (int ch = 0; ch < AGG_CHANNEL_COUNT; ch++) {
+        accumulate(acc[ch], *channelPtr(&snap, ch));
+    }
+}
+
+bool closeTelemetryAggregateWindow(SensorSnapshot* snap) {
+    if (!aggregateEnabled || acc[0].n == 0) {
+        lastWindowSamples = 0;
+        return false;
+    }
+
+    for (int ch = 0; ch < AGG_CHANNEL_COUNT; ch++) {
+        const Accumulator& a = acc[ch];
+        lastWindow[ch].min = a.min;
+        lastWindow[ch].max = a.max;
+        lastWindow[ch].stddev = sqrtf(a.m2 / (float)a.n);
+        if (snap != nullptr) {
+            *channelPtr(snap, ch) = a.mean;
+        }
+    }
+    lastWindowSamples = acc[0].n;
+    resetAccumulators();
+    return true;
+}
+
+bool getTelemetryAggregateStat(AggChannel ch, AggStat stat, float* out) {
+    if (lastWindowSamples == 0 || ch >= AGG_CHANNEL_COUNT || out == nullptr) {
+        return false;
+    }
+    switch (stat) {
+        case AGG_STAT_MIN:    *out = lastWindow[ch].min; break;
+        case AGG_STAT_MAX:    *out = lastWindow[ch].max; break;
+        case AGG_STAT_STDDEV: *out = lastWindow[ch].stddev; break;
+        default:              return false;
+    }
+    return true;
+}
+
+bool optAggSamples(const SensorSnapshot& snap, uint32_t* out) {
+    (void)snap;
+    *out = lastWindowSamples;
+    return lastWindowSamples > 0;
+}
@@ -4,6 +4,10 @@
 #include "Timing.h"
 #include "Commands.h"
 #include "XBee.h"
+#include "LinkScheduler.h"
+#include "CsvWriter.h"
+#include "OptionalFields.h"
+#include "TelemetryAggregate.h"
 #include <Arduino.h>
 #include <EEPROM.h>  // Teensy 4.1 EEPROM library
 #include <stdio.h>
@@ -14,6 +18,19 @@ static uint32_t packetCount = 0;
 static TelemetryMode telemetryMode = MODE_FLIGHT;
 static char commandEcho[32] = "";
 static uint32_t lastSuccessfulSendMs = 0;  // For link status / diagnostics
+static uint32_t lastBuildMicros = 0;       // Packet-build time of the last sendTelemetry()
+static bool buildTimed = false;            // lastBuildMicros holds a measurement
+
+// Packet buffer (static, not on the stack); CsvWriter formats straight into it.
+static char packetBuf[512];
+
+// Mandated column names (Section 3.1.1.1), in wire order. OPTIONAL_DATA names follow.
+static const char* const MANDATED_FIELD_NAMES[] = {
+    "TEAM_ID", "MISSION_TIME", "PACKET_COUNT", "MODE", "STATE", "ALTITUDE",
+    "TEMPERATURE", "PRESSURE", "VOLTAGE", "CURRENT", "GYRO_R", "GYRO_P", "GYRO_Y",
+    "ACCEL_R", "ACCEL_P", "ACCEL_Y", "GPS_TIME", "GPS_ALTITUDE", "GPS_LATITUDE",
+    "GPS_LONGITUDE", "GPS_SATS", "CMD_ECHO"
+};
 
 // EEPROM address for packet count persistence (required: F1)
 // Reserve addresses 20-23 for packet count (4 bytes)
@@ -35,6 +52,14 @@ void initTelemetry() {
 }
 
 void setTelemetryEnabled(bool enabled) {
+    if (enabled && !telemetryEnabled) {
+        // USB-only: column names for the GCS CSV (not sent over the radio).
+        char header[512];
+        if (formatTelemetryHeader(header, sizeof(header)) > 0) {
+            Serial.print(header);
+        }
+        restartTelemetryAggregateWindow();
+    }
     telemetryEnabled = enabled;
 }
 
@@ -96,6 +121,27 @@ const char* getCommandEcho() {
     return commandEcho;
 }
 
+size_t formatTelemetryHeader(char* buf, size_t cap) {
+    CsvWriter w;
+    csvBegin(&w, buf, cap);
+    for (size_t i = 0; i < sizeof(MANDATED_FIELD_NAMES) / sizeof(MANDATED_FIELD_NAMES[0]); i++) {
+        csvPutStr(&w, MANDATED_FIELD_NAMES[i]);
+    }
+    writeOptionalFieldNames(&w);
+    return csvEnd(&w);
+}
+
+uint32_t getTelemetryBuildMicros() {
+    return lastBuildMicros;
+}
+
+bool optTelemetryBuildMicros(const SensorSnapshot& snap, uint32_t* out) {
+    (void)snap;
+    if (!buildTimed) return false;
+    *out = lastBuildMicros;
+    return true;
+}
+
 void sendTelemetry() {
     if (!telemetryEnabled) {
         return;
@@ -105,58 +151,63 @@ void sendTelemetry() {
     // TEAM_ID, MISSION_TIME, PACKET_COUNT, MODE, STATE, ALTITUDE, TEMPERATURE, 
     // PRESSURE, VOLTAGE, CURRENT, GYRO_R, GYRO_P, GYRO_Y, ACCEL_R, ACCEL_P, ACCEL_Y,
     // GPS_TIME, GPS_ALTITUDE, GPS_LATITUDE, GPS_LONGITUDE, GPS_SATS, CMD_ECHO [,OPTIONAL_DATA]
-    
-    char buffer[512];
-    char missionTimeStr[9];
-    char gpsTimeStr[9];
-    
-    // Get mission time
+    //
+    // Built field by field with CsvWriter (integer formatting, no "%f"); the mandated
+    // fields are byte-identical to the former "%04d,%s,%lu,%c,%s,%.1f,...,%d,%s" format.
+    //
+    // Every value comes from ONE SensorSnapshot (the last updateSensors() pass), so
+    // the packet describes a single instant; its capture time is the CAPTURE_MS column.
+    uint32_t buildStartUs = micros();
+    SensorSnapshot snap;
+    captureSensorSnapshot(&snap);
+    // AGG mode: channel columns become 1 s window means; AGG_* columns get min/max/sd.
+    closeTelemetryAggregateWindow(&snap);
     uint8_t h, m, s;
-    if (getMissionTime(h, m, s)) {
-        snprintf(missionTimeStr, sizeof(missionTimeStr), "%02d:%02d:%02d", h, m, s);
+    bool missionTimeValid = getMissionTime(h, m, s);
+
+    CsvWriter w;
+    csvBegin(&w, packetBuf, sizeof(packetBuf));
+
+    csvPutUInt(&w, getTeamID(), 4);                     // TEAM_ID
+    if (missionTimeValid) {                             // MISSION_TIME
+        csvPutTime(&w, h, m, s);
     } else {
-        strcpy(missionTimeStr, "00:00:00");
+        csvPutStr(&w, "00:00:00");
     }
-    
-    // Get GPS time
-    uint8_t gpsH, gpsM, gpsS;
-    bool gpsValid = getGPSTime(gpsH, gpsM, gpsS);
-    if (gpsValid) {
-        snprintf(gpsTimeStr, sizeof(gpsTimeStr), "%02d:%02d:%02d", gpsH, gpsM, gpsS);
+    csvPutUInt(&w, packetCount);                        // PACKET_COUNT
+    csvPutChar(&w, (telemetryMode == MODE_FLIGHT) ? 'F' : 'S');  // MODE
+    csvPutStr(&w, flightStateToString(flightState));    // STATE
+    csvPutFixed(&w, snap.altitude, 1);                  // ALTITUDE (0.1m resolution)
+    csvPutFixed(&w, snap.temperature, 1);               // TEMPERATURE (0.1°C resolution)
+    csvPutFixed(&w, snap.pressure, 1);                  // PRESSURE (0.1 kPa resolution)
+    csvPutFixed(&w, snap.voltage, 1);                   // VOLTAGE (0.1V resolution)
+    csvPutFixed(&w, snap.current, 2);                   // CURRENT (0.01A resolution)
+    csvPutFixed(&w, snap.gyroR, 1);                     // GYRO_R
+    csvPutFixed(&w, snap.gyroP, 1);                     // GYRO_P
+    csvPutFixed(&w, snap.gyroY, 1);                     // GYRO_Y
+    csvPutFixed(&w, snap.accelR, 1);                    // ACCEL_R
+    csvPutFixed(&w, snap.accelP, 1);                    // ACCEL_P
+    csvPutFixed(&w, snap.accelY, 1);                    // ACCEL_Y
+    if (snap.gpsTimeValid) {                            // GPS_TIME
+        csvPutTime(&w, snap.gpsHour, snap.gpsMinute, snap.gpsSecond);
     } else {
-        strcpy(gpsTimeStr, "00:00:00");
+        csvPutStr(&w, "00:00:00");
     }
+    csvPutFixed(&w, snap.gpsAltitude, 1);               // GPS_ALTITUDE (0.1m resolution)
+    csvPutFixed(&w, snap.gpsLatitude, 4);               // GPS_LATITUDE (0.0001° resolution)
+    csvPutFixed(&w, snap.gpsLongitude, 4);              // GPS_LONGITUDE (0.0001° resolution)
+    csvPutUInt(&w, snap.gpsSatellites);                 // GPS_SATS
+    csvPutStr(&w, commandEcho);                         // CMD_ECHO
+    writeOptionalFields(&w, snap);                      // OPTIONAL_DATA (registry order)
+
+    size_t packetLen = csvEnd(&w);
+    lastBuildMicros = micros() - buildStartUs;
+    buildTimed = true;
     
-    // Format telemetry packet (use current team ID from Commands)
-    snprintf(buffer, sizeof(buffer),
-        "%04d,%s,%lu,%c,%s,%.1f,%.1f,%.1f,%.1f,%.2f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%s,%.1f,%.4f,%.4f,%d,%s\r\n",
-        getTeamID(),                                // TEAM_ID
-        missionTimeStr,                           // MISSION_TIME
-        packetCount,                              // PACKET_COUNT
-        (telemetryMode == MODE_FLIGHT) ? 'F' : 'S', // MODE
-        flightStateToString(flightState),         // STATE
-        getAltitude(),                            // ALTITUDE (0.1m resolution)
-        getTemperature(),                         // TEMPERATURE (0.1°C resolution)
-        getPressure(),                            // PRESSURE (0.1 kPa resolution)
-        getBatteryVoltage(),                      // VOLTAGE (0.1V resolution)
-        getBatteryCurrent(),                      // CURRENT (0.01A resolution)
-        getGyroRoll(),                           // GYRO_R
-        getGyroPitch(),                          // GYRO_P
-        getGyroYaw(),                            // GYRO_Y
-        getAccelRoll(),                          // ACCEL_R
-        getAccelPitch(),                         // ACCEL_P
-        getAccelYaw(),                           // ACCEL_Y
-        gpsTimeStr,                              // GPS_TIME
-        getGPSAltitude(),                        // GPS_ALTITUDE (0.1m resolution)
-        getGPSLatitude(),                         // GPS_LATITUDE (0.0001° resolution)
-        getGPSLongitude(),                        // GPS_LONGITUDE (0.0001° resolution)
-        getGPSSatellites(),                       // GPS_SATS
-        commandEcho                               // CMD_ECHO
-    );
-    
-    // Send via XBee
-    xbeeSend((const uint8_t*)buffer, strlen(buffer));
-    lastSuccessfulSendMs = millis();
+    // Queue via the link scheduler (strict priority; returns immediately, drained by updateXBee)
+    if (packetLen > 0 && linkSubmit(LINK_TELEMETRY, (const uint8_t*)packetBuf, packetLen)) {
+        lastSuccessfulSendMs = millis();
+    }
     incrementPacketCount();
 
     // Debug: send raw NMEA sentence over XBee (and USB Serial) so GPS status is visible
@@ -170,8 +221,9 @@ void sendTelemetry() {
         } else {
             snprintf(gpsDebug, sizeof(gpsDebug), "[GPS_RAW] (no NMEA received)\r\n");
         }
-        xbeeSend((const uint8_t*)gpsDebug, strlen(gpsDebug));
-        Serial.print(buffer);
+        // Debug class: only uses leftover airtime, dropped rather than delaying telemetry.
+        linkSubmit(LINK_DEBUG, (const uint8_t*)gpsDebug, strlen(gpsDebug));
+        Serial.print(packetBuf);
         Serial.print(gpsDebug);
     }
 }
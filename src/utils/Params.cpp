@@ -0,0 +1,271 @@
+// Parameter registry storage and persistence (see Params.h).
+#include "Params.h"
+#include "FlightState.h"
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PARAM_INFO_ENTRY(id, name, type, def, lo, hi) { name, type, def, lo, hi },
+static constexpr ParamInfo PARAM_INFO[PARAM_COUNT] = {
+    PARAM_LIST(PARAM_INFO_ENTRY)
+};
+#undef PARAM_INFO_ENTRY
+
+float paramValues[PARAM_COUNT];
+
+// Set when a change arrived in flight; saved once back on the ground.
+static bool savePending = false;
+
+// EEPROM parameter block (addresses 100-619):
+//   100 magic (u32), 104 entry count (u16), 106 CRC-16 of count + entries (u16),
+//   108 entries of 8 bytes: name/type hash (u32), value (float bits).
+// Entries are matched by hash, not position, so a build that appends (or drops)
+// parameters still loads every stored value whose name and type it knows.
+const int EEPROM_PARAM_MAGIC_ADDR = 100;
+const int EEPROM_PARAM_COUNT_ADDR = 104;
+const int EEPROM_PARAM_CRC_ADDR = 106;
+const int EEPROM_PARAM_ENTRIES_ADDR = 108;
+const int PARAM_ENTRY_BYTES = 8;
+const uint16_t PARAM_STORE_SLOTS = 64;
+const uint32_t PARAM_BLOCK_MAGIC = 0x324D5250UL;  // "PRM2"
+static_assert(PARAM_COUNT <= PARAM_STORE_SLOTS, "Parameter table outgrew its EEPROM block");
+
+// Compile-time checks: unique names, sane bounds, defaults in range and whole
+// numbers for PARAM_U32.
+static constexpr bool sameName(const char* a, const char* b) {
+    while (*a != '\0' && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+static constexpr bool tableValid() {
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        const ParamInfo& p = PARAM_INFO[i];
+        if (p.name == nullptr || p.name[0] == '\0') return false;
+        if (!(p.minValue <= p.defaultValue && p.defaultValue <= p.maxValue)) return false;
+        if (p.type == PARAM_U32 && (p.minValue < 0.0f || p.defaultValue != (float)(uint32_t)p.defaultValue)) {
+            return false;
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (sameName(p.name, PARAM_INFO[j].name)) return false;
+        }
+    }
+    return true;
+}
+static_assert(tableValid(), "Parameter table: duplicate name, default out of bounds or fractional U32");
+
+// FNV-1a over a parameter's name and type: identifies its stored entry.
+static constexpr uint32_t entryHash(const ParamInfo& p, uint32_t h = 2166136261UL) {
+    for (const char* s = p.name; *s != '\0'; ++s) {
+        h = (h ^ (uint8_t)*s) * 16777619UL;
+    }
+    return (h ^ (uint8_t)p.type) * 16777619UL;
+}
+
+static constexpr bool hashesUnique() {
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        for (size_t j = 0; j < i; j++) {
+            if (entryHash(PARAM_INFO[i]) == entryHash(PARAM_INFO[j])) return false;
+        }
+    }
+    return true;
+}
+static_assert(hashesUnique(), "Parameter table: two names hash alike, rename one");
+
+static uint32_t eepromReadU32(int addr) {
+    return (uint32_t)EEPROM.read(addr) | ((uint32_t)EEPROM.read(addr + 1) << 8) |
+           ((uint32_t)EEPROM.read(addr + 2) << 16) | ((uint32_t)EEPROM.read(addr + 3) << 24);
+}
+
+static void eepromUpdateU32(int addr, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        EEPROM.update(addr + i, (uint8_t)(v >> (8 * i)));
+    }
+}
+
+static uint32_t floatBits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static uint16_t crcByte(uint16_t crc, uint8_t b) {
+    // CRC-16/CCITT-FALSE
+    crc ^= (uint16_t)b << 8;
+    for (int k = 0; k < 8; k++) {
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+// CRC of the bytes as stored in EEPROM from addr on.
+static uint16_t eepromCrc(int addr, int len, uint16_t crc = 0xFFFF) {
+    for (int i = 0; i < len; i++) {
+        crc = crcByte(crc, EEPROM.read(addr + i));
+    }
+    return crc;
+}
+
+static uint16_t eepromReadU16(int addr) {
+    return (uint16_t)EEPROM.read(addr) | ((uint16_t)EEPROM.read(addr + 1) << 8);
+}
+
+static void eepromUpdateU16(int addr, uint16_t v) {
+    EEPROM.update(addr, (uint8_t)(v & 0xFF));
+    EEPROM.update(addr + 1, (uint8_t)(v >> 8));
+}
+
+static bool valueAllowed(const ParamInfo& p, float v) {
+    if (!isfinite(v) || v < p.minValue || v > p.maxValue) return false;
+    if (p.type == PARAM_U32 && v != floorf(v)) return false;
+    return true;
+}
+
+// Write the whole block (EEPROM.update only touches bytes that changed).
+static void saveParams() {
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        int addr = EEPROM_PARAM_ENTRIES_ADDR + PARAM_ENTRY_BYTES * (int)i;
+        eepromUpdateU32(addr, entryHash(PARAM_INFO[i]));
+        eepromUpdateU32(addr + 4, floatBits(paramValues[i]));
+    }
+    eepromUpdateU16(EEPROM_PARAM_COUNT_ADDR, (uint16_t)PARAM_COUNT);
+    uint16_t crc = eepromCrc(EEPROM_PARAM_COUNT_ADDR, 2);
+    crc = eepromCrc(EEPROM_PARAM_ENTRIES_ADDR, PARAM_ENTRY_BYTES * (int)PARAM_COUNT, crc);
+    eepromUpdateU16(EEPROM_PARAM_CRC_ADDR, crc);
+    eepromUpdateU32(EEPROM_PARAM_MAGIC_ADDR, PARAM_BLOCK_MAGIC);
+}
+
+static void loadDefaults() {
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        paramValues[i] = PARAM_INFO[i].defaultValue;
+    }
+}
+
+// Stored entry for a hash: same slot first (the usual case), else a scan.
+static int findStoredEntry(uint32_t hash, size_t hint, uint16_t stored) {
+    if (hint < stored &&
+        eepromReadU32(EEPROM_PARAM_ENTRIES_ADDR + PARAM_ENTRY_BYTES * (int)hint) == hash) {
+        return (int)hint;
+    }
+    for (uint16_t k = 0; k < stored; k++) {
+        if (eepromReadU32(EEPROM_PARAM_ENTRIES_ADDR + PARAM_ENTRY_BYTES * k) == hash) return k;
+    }
+    return -1;
+}
+
+void initParams() {
+    loadDefaults();
+    if (eepromReadU32(EEPROM_PARAM_MAGIC_ADDR) != PARAM_BLOCK_MAGIC) {
+        return;  // Never saved
+    }
+
+    uint16_t stored = eepromReadU16(EEPROM_PARAM_COUNT_ADDR);
+    uint16_t crc = 0;
+    if (stored <= PARAM_STORE_SLOTS) {
+        crc = eepromCrc(EEPROM_PARAM_COUNT_ADDR, 2);
+        crc = eepromCrc(EEPROM_PARAM_ENTRIES_ADDR, PARAM_ENTRY_BYTES * stored, crc);
+    }
+    if (stored > PARAM_STORE_SLOTS || crc != eepromReadU16(EEPROM_PARAM_CRC_ADDR)) {
+        Serial.println("Params: stored block corrupt, using defaults");
+        return;
+    }
+
+    // Parameters this build added keep their defaults; stored entries it no longer
+    // has (or whose value is now out of bounds) are skipped.
+    size_t loaded = 0;
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        int k = findStoredEntry(entryHash(PARAM_INFO[i]), i, stored);
+        if (k < 0) continue;
+        uint32_t u = eepromReadU32(EEPROM_PARAM_ENTRIES_ADDR + PARAM_ENTRY_BYTES * k + 4);
+        float v;
+        memcpy(&v, &u, sizeof(v));
+        if (valueAllowed(PARAM_INFO[i], v)) {
+            paramValues[i] = v;
+            loaded++;
+        }
+    }
+    if (loaded != PARAM_COUNT || stored != PARAM_COUNT) {
+        Serial.print("Params: loaded ");
+        Serial.print((unsigned long)loaded);
+        Serial.print(" of ");
+        Serial.print((unsigned long)PARAM_COUNT);
+        Serial.print(" (");
+        Serial.print((unsigned long)stored);
+        Serial.println(" stored)");
+    }
+}
+
+const ParamInfo* paramInfo(ParamId id) {
+    return ((size_t)id < PARAM_COUNT) ? &PARAM_INFO[id] : nullptr;
+}
+
+bool paramFind(const char* nameOrId, ParamId* out) {
+    if (nameOrId == nullptr || out == nullptr || *nameOrId == '\0') return false;
+    if (nameOrId[0] >= '0' && nameOrId[0] <= '9') {
+        char* end;
+        unsigned long id = strtoul(nameOrId, &end, 10);
+        if (*end != '\0' || id >= PARAM_COUNT) return false;
+        *out = (ParamId)id;
+        return true;
+    }
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        if (strcmp(nameOrId, PARAM_INFO[i].name) == 0) {
+            *out = (ParamId)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// EEPROM writes stall the loop (flash erase on Teensy 4.x), so in flight a change
+// only updates RAM and updateParams() saves it after landing.
+static void saveOrDefer() {
+    if (isGroundState(flightState)) {
+        saveParams();
+        savePending = false;
+    } else {
+        savePending = true;
+    }
+}
+
+bool paramSet(ParamId id, float value) {
+    if ((size_t)id >= PARAM_COUNT || !valueAllowed(PARAM_INFO[id], value)) {
+        return false;
+    }
+    if (paramValues[id] != value) {
+        paramValues[id] = value;
+        saveOrDefer();
+    }
+    return true;
+}
+
+void paramResetAll() {
+    loadDefaults();
+    saveOrDefer();
+}
+
+bool paramsSavePending() {
+    return savePending;
+}
+
+void updateParams() {
+    if (savePending && isGroundState(flightState)) {
+        saveParams();
+        savePending = false;
+        Serial.println("Params: saved changes made in flight");
+    }
+}
+
+size_t paramFormat(ParamId id, float value, char* out, size_t cap) {
+    int n;
+    if ((size_t)id < PARAM_COUNT && PARAM_INFO[id].type == PARAM_U32) {
+        n = snprintf(out, cap, "%lu", (unsigned long)value);
+    } else {
+        n = snprintf(out, cap, "%.6g", (double)value);
+    }
+    return (n > 0 && (size_t)n < cap) ? (size_t)n : 0;
+}
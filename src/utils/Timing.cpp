@@ -1,5 +1,8 @@
 #include "Timing.h"
+#include "EventJournal.h"
 #include "Sensors.h"
+#include "Params.h"
+#include "FlightState.h"
 #include <Arduino.h>
 #include <EEPROM.h>  // Teensy 4.1 EEPROM library (emulated in flash)
 #include <math.h>
@@ -9,44 +12,224 @@ static uint8_t missionHour = 0;
 static uint8_t missionMinute = 0;
 static uint8_t missionSecond = 0;
 static bool timeSet = false;
-static uint32_t missionTimeOffset = 0;  // Offset from system time
+
+// Monotonic time base: micros() extended to 64 bits by counting its wraps
+// (every ~71.6 min). Any caller extends it; updateTiming() runs every tick, so a
+// wrap is never missed.
+static uint32_t lastMicros32 = 0;
+static uint32_t microsHigh = 0;
+
+// UTC mapping, fixed point in nanoseconds: mission time of day =
+// (monotonic + offset) mod one day, where the offset changes linearly at
+// slewPpb from slewAnchorUs on. ST sets the offset once, so reads never jump
+// because of how the set instant and the read instant were rounded; the GPS
+// discipline only ever changes the slew rate, re-anchoring first, so the
+// mapping stays continuous.
+static const uint64_t US_PER_DAY = 86400ULL * 1000000ULL;
+static int64_t utcOffsetNs = 0;
+static uint64_t slewAnchorUs = 0;
+static int32_t slewPpb = 0;
+
+// GPS discipline: a type-2 PI loop on the phase error measured at each GPS fix
+// epoch. The integral term is the crystal frequency correction; the proportional
+// term pulls the phase in with a ~2 min time constant. The rate is limited, so
+// corrections are slews (mission time never steps or runs backwards).
+static const float DISC_KP = 0.0118f;          // 1/s   (2*zeta/tau, zeta 0.707, tau 120 s)
+static const float DISC_KI = 1.0f / 14400.0f;  // 1/s^2 (1/tau^2)
+static const int32_t DISC_MAX_FREQ_PPB = 200000;   // Crystal tolerance bound (200 ppm)
+static const int32_t DISC_MAX_SLEW_PPB = 500000;   // 0.5 ms per second at most
+static const int64_t DISC_STEER_LIMIT_US = 1000000;  // Steer phase to GPS only within 1 s
+static const int64_t DISC_OUTLIER_US = 250000;
+static const uint32_t DISC_GAP_RESTART_US = 10000000;
+static const uint32_t DISC_LOCK_EPOCHS = 30;
+
+static uint32_t lastGpsEpoch = 0;
+static uint64_t lastEpochUs = 0;
+static bool discRunning = false;
+static int64_t discTargetUs = 0;   // Phase error the loop steers to (0 = GPS time)
+static float discFreqPpb = 0.0f;
+static ClockDisciplineStatus disc;
 
 // EEPROM addresses for persistent storage (Teensy 4.1 has 8KB EEPROM emulation)
 // Reserve addresses 0-15 for mission time data
 const int EEPROM_MISSION_TIME_ADDR = 0;
+const int EEPROM_RTC_OFFSET_ADDR = 3;      // u32: mission time minus RTC, RTC ticks mod one day
 const int EEPROM_TIME_SET_FLAG_ADDR = 10;
+const int EEPROM_RTC_ANCHOR_ADDR = 11;     // u32: RTC seconds when the offset was stored
+
+// Battery-backed SNVS RTC: a 47-bit counter at 32768 Hz that keeps running across
+// resets. ST stores (mission time - RTC) once; after a reset mission time is the
+// RTC plus that offset, exact to one 30.5 us tick, available in initTiming()
+// with no EEPROM traffic afterwards. On the ground the stored offset is refreshed
+// when GPS discipline has moved mission time away from the RTC by more than
+// RTC_RESAVE_DRIFT_US (the two crystals drift apart); in flight EEPROM is never
+// written.
+static const uint32_t RTC_HZ = 32768;
+static const uint64_t RTC_TICKS_PER_DAY = 86400ULL * RTC_HZ;
+static const uint32_t RTC_MAX_ANCHOR_AGE_S = 7UL * 86400;  // Older offsets are not trusted
+static const int64_t RTC_RESAVE_DRIFT_US = 2000;
+static const uint32_t RTC_CHECK_PERIOD_US = 10000000;
+static uint32_t rtcOffsetTicks = 0;
+static bool rtcAnchored = false;
+static uint64_t lastRtcCheckUs = 0;
 
 void initTiming() {
     // Restore mission time from persistent storage (required: F2 - maintain through resets)
     restoreMissionTime();
     // Mission time is set by ground command (ST) to within 1 second UTC (F3).
-    // No RTC hardware required; time is derived from millis() + stored offset.
+    // Time is derived from the monotonic clock + offset, anchored to the SNVS RTC
+    // so that it continues across resets.
+}
+
+// Whole RTC counter, or false if the RTC is not running.
+static bool readRtcTicks(uint64_t* ticks) {
+#ifdef SNVS_LPSRTCMR
+    if (!(SNVS_LPCR & SNVS_LPCR_SRTC_ENV)) {
+        return false;
+    }
+    // The counter runs in another clock domain: read until two reads agree.
+    uint32_t hi1, lo1, hi2, lo2;
+    hi1 = SNVS_LPSRTCMR;
+    lo1 = SNVS_LPSRTCLR;
+    for (;;) {
+        hi2 = SNVS_LPSRTCMR;
+        lo2 = SNVS_LPSRTCLR;
+        if (hi1 == hi2 && lo1 == lo2) break;
+        hi1 = hi2;
+        lo1 = lo2;
+    }
+    *ticks = ((uint64_t)(hi1 & 0x7FFF) << 32) | lo1;
+    return true;
+#else
+    (void)ticks;
+    return false;
+#endif
+}
+
+static void eepromWriteU32(int addr, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        EEPROM.update(addr + i, (uint8_t)(v >> (8 * i)));
+    }
+}
+
+static uint32_t eepromReadU32(int addr) {
+    return (uint32_t)EEPROM.read(addr) | ((uint32_t)EEPROM.read(addr + 1) << 8) |
+           ((uint32_t)EEPROM.read(addr + 2) << 16) | ((uint32_t)EEPROM.read(addr + 3) << 24);
+}
+
+// Mission time of day implied by the RTC and the stored offset.
+static uint64_t rtcMissionUs(uint64_t rtcTicks) {
+    uint64_t ticksOfDay = (rtcTicks + rtcOffsetTicks) % RTC_TICKS_PER_DAY;
+    return ticksOfDay * 1000000ULL / RTC_HZ;
+}
+
+uint64_t getMonotonicUs() {
+    uint32_t now = micros();
+    if (now < lastMicros32) {
+        microsHigh++;
+    }
+    lastMicros32 = now;
+    return ((uint64_t)microsHigh << 32) | now;
+}
+
+static int64_t offsetNsAt(uint64_t monoUs) {
+    return utcOffsetNs + (int64_t)(monoUs - slewAnchorUs) * slewPpb / 1000000;
+}
+
+// Change the slew rate from now on without moving the mapping.
+static void setSlewPpb(int32_t ppb) {
+    uint64_t now = getMonotonicUs();
+    utcOffsetNs = offsetNsAt(now);
+    slewAnchorUs = now;
+    slewPpb = ppb;
+}
+
+static uint64_t missionUsAt(uint64_t monoUs) {
+    int64_t t = ((int64_t)monoUs * 1000 + offsetNsAt(monoUs)) / 1000 % (int64_t)US_PER_DAY;
+    return (uint64_t)(t < 0 ? t + (int64_t)US_PER_DAY : t);
+}
+
+// Anchor mission time so that it reads usOfDay now. The frequency estimate is
+// kept; the phase loop restarts from the next GPS epoch.
+static void setUtcOffset(uint64_t usOfDay) {
+    uint64_t now = getMonotonicUs();
+    utcOffsetNs = ((int64_t)usOfDay - (int64_t)now) * 1000;
+    slewAnchorUs = now;
+    slewPpb = (int32_t)discFreqPpb;
+    discRunning = false;
 }
 
 bool timeSetComplete() {
     return timeSet;
 }
 
-bool getMissionTime(uint8_t& hour, uint8_t& minute, uint8_t& second) {
+bool getMissionTimeUs(uint64_t& usOfDay) {
     if (!timeSet) {
         return false;
     }
-    
-    // Calculate current mission time from offset
-    uint32_t now = millis();
-    uint32_t totalSeconds = missionTimeOffset + (now / 1000);
-    
-    uint32_t seconds = totalSeconds % 60;
-    uint32_t minutes = (totalSeconds / 60) % 60;
-    uint32_t hours = (totalSeconds / 3600) % 24;
-    
-    hour = (uint8_t)hours;
-    minute = (uint8_t)minutes;
-    second = (uint8_t)seconds;
-    
+    usOfDay = missionUsAt(getMonotonicUs());
     return true;
 }
 
+bool getMissionTimeMs(uint32_t& msOfDay) {
+    uint64_t us;
+    if (!getMissionTimeUs(us)) {
+        return false;
+    }
+    msOfDay = (uint32_t)(us / 1000);
+    return true;
+}
+
+bool getMissionTime(uint8_t& hour, uint8_t& minute, uint8_t& second) {
+    uint32_t ms;
+    if (!getMissionTimeMs(ms)) {
+        return false;
+    }
+
+    uint32_t totalSeconds = ms / 1000;
+    hour = (uint8_t)(totalSeconds / 3600);
+    minute = (uint8_t)((totalSeconds / 60) % 60);
+    second = (uint8_t)(totalSeconds % 60);
+    return true;
+}
+
+// Fixed layout: two digits per field, optional ".mmm" with exactly three digits.
+bool parseTimeOfDayMs(const char* timeStr, uint32_t& msOfDay) {
+    if (timeStr == nullptr) {
+        return false;
+    }
+    size_t len = strlen(timeStr);
+    if (len != 8 && len != 12) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        char c = timeStr[i];
+        bool sep = (i == 2 || i == 5) ? (c == ':') : (i == 8) ? (c == '.') : (c >= '0' && c <= '9');
+        if (!sep) {
+            return false;
+        }
+    }
+    uint32_t h = (timeStr[0] - '0') * 10 + (timeStr[1] - '0');
+    uint32_t m = (timeStr[3] - '0') * 10 + (timeStr[4] - '0');
+    uint32_t s = (timeStr[6] - '0') * 10 + (timeStr[7] - '0');
+    uint32_t frac = 0;
+    if (len == 12) {
+        frac = (timeStr[9] - '0') * 100 + (timeStr[10] - '0') * 10 + (timeStr[11] - '0');
+    }
+    if (h >= 24 || m >= 60 || s >= 60) {
+        return false;
+    }
+    msOfDay = ((h * 60 + m) * 60 + s) * 1000 + frac;
+    return true;
+}
+
+// Journal a time change; source 0 = ST, 1 = ST,GPS, 2 = restored from the RTC.
+static void journalTimeSet(uint8_t source) {
+    uint32_t ms = 0;
+    getMissionTimeMs(ms);
+    journalEvent(EVT_TIME_SET, source, ms);
+}
+
 bool setMissionTime(const char* timeStr) {
     // Parse UTC time string "hh:mm:ss" (required: ST command)
     if (timeStr == nullptr) {
@@ -65,21 +248,10 @@ bool setMissionTime(const char* timeStr) {
             missionHour = h;
             missionMinute = m;
             missionSecond = s;
-            
-            // Calculate offset from current system time
-            uint32_t now = millis();
-            uint32_t currentSeconds = (now / 1000) % 86400;  // Seconds since midnight
-            uint32_t missionSeconds = h * 3600 + m * 60 + s;
-            
-            // Handle wrap-around
-            if (missionSeconds > currentSeconds) {
-                missionTimeOffset = missionSeconds - currentSeconds;
-            } else {
-                missionTimeOffset = 86400 - (currentSeconds - missionSeconds);
-            }
-            
+            setUtcOffset(((uint64_t)h * 3600 + m * 60 + s) * 1000000ULL);
             timeSet = true;
             saveMissionTime();
+            journalTimeSet(0);
             return true;
         }
     }
@@ -98,21 +270,10 @@ bool setMissionTimeFromGPS() {
         missionHour = h;
         missionMinute = m;
         missionSecond = s;
-
-        // Calculate offset from current system time
-        uint32_t now = millis();
-        uint32_t currentSeconds = (now / 1000) % 86400;  // Seconds since midnight
-        uint32_t missionSeconds = h * 3600 + m * 60 + s;
-
-        // Handle wrap-around
-        if (missionSeconds > currentSeconds) {
-            missionTimeOffset = missionSeconds - currentSeconds;
-        } else {
-            missionTimeOffset = 86400 - (currentSeconds - missionSeconds);
-        }
-
+        setUtcOffset(((uint64_t)h * 3600 + m * 60 + s) * 1000000ULL);
         timeSet = true;
         saveMissionTime();
+        journalTimeSet(1);
         return true;
     }
 
@@ -132,6 +293,20 @@ void saveMissionTime() {
     EEPROM.write(EEPROM_MISSION_TIME_ADDR + 1, missionMinute);
     EEPROM.write(EEPROM_MISSION_TIME_ADDR + 2, missionSecond);
     EEPROM.write(EEPROM_TIME_SET_FLAG_ADDR, timeSet ? 1 : 0);
+
+    // Anchor to the RTC: offset between mission time and the RTC at this instant.
+    uint64_t rtc, missionUs;
+    rtcAnchored = false;
+    if (timeSet && getMissionTimeUs(missionUs) && readRtcTicks(&rtc)) {
+        uint64_t missionTicks = missionUs * RTC_HZ / 1000000ULL;
+        rtcOffsetTicks = (uint32_t)((missionTicks + RTC_TICKS_PER_DAY - rtc % RTC_TICKS_PER_DAY) %
+                                    RTC_TICKS_PER_DAY);
+        eepromWriteU32(EEPROM_RTC_OFFSET_ADDR, rtcOffsetTicks);
+        eepromWriteU32(EEPROM_RTC_ANCHOR_ADDR, (uint32_t)(rtc / RTC_HZ));
+        rtcAnchored = true;
+    } else {
+        eepromWriteU32(EEPROM_RTC_ANCHOR_ADDR, 0);
+    }
     
     // Note: EEPROM.commit() is not needed on Teensy - writes are immediate
     // However, writes are cached and may be delayed, so we can force a commit if needed
@@ -155,21 +330,121 @@ void restoreMissionTime() {
         timeSet = false;
     }
     
-    // Recalculate offset
-    if (timeSet) {
-        uint32_t now = millis();
-        uint32_t currentSeconds = (now / 1000) % 86400;
-        uint32_t missionSeconds = missionHour * 3600 + missionMinute * 60 + missionSecond;
-        
-        if (missionSeconds > currentSeconds) {
-            missionTimeOffset = missionSeconds - currentSeconds;
-        } else {
-            missionTimeOffset = 86400 - (currentSeconds - missionSeconds);
-        }
+    if (!timeSet) {
+        return;
+    }
+
+    // Continue from the RTC if it kept running since the offset was stored.
+    uint64_t rtc = 0;
+    uint32_t anchorS = eepromReadU32(EEPROM_RTC_ANCHOR_ADDR);
+    if (anchorS != 0 && readRtcTicks(&rtc) && rtc / RTC_HZ >= anchorS &&
+        rtc / RTC_HZ - anchorS < RTC_MAX_ANCHOR_AGE_S) {
+        rtcOffsetTicks = eepromReadU32(EEPROM_RTC_OFFSET_ADDR);
+        rtcAnchored = (rtcOffsetTicks < RTC_TICKS_PER_DAY);
     }
+    if (rtcAnchored) {
+        setUtcOffset(rtcMissionUs(rtc));
+        journalTimeSet(2);
+        return;
+    }
+
+    // No usable RTC: fall back to the time that was set (it restarts from there).
+    setUtcOffset(((uint64_t)missionHour * 3600 + missionMinute * 60 + missionSecond) * 1000000ULL);
+}
+
+bool isMissionTimeFromRtc() {
+    return timeSet && rtcAnchored;
+}
+
+// Refresh the stored RTC offset once GPS discipline has moved mission time away
+// from the RTC - on the ground only, so flight never waits on an EEPROM write.
+static void checkRtcAnchor() {
+    uint64_t now = getMonotonicUs();
+    if (!timeSet || !rtcAnchored || now - lastRtcCheckUs < RTC_CHECK_PERIOD_US) {
+        return;
+    }
+    lastRtcCheckUs = now;
+    if (!isGroundState(flightState)) {
+        return;
+    }
+    uint64_t rtc, missionUs;
+    if (!readRtcTicks(&rtc) || !getMissionTimeUs(missionUs)) {
+        return;
+    }
+    int64_t diff = ((int64_t)missionUs - (int64_t)rtcMissionUs(rtc)) % (int64_t)US_PER_DAY;
+    if (diff > (int64_t)US_PER_DAY / 2) diff -= US_PER_DAY;
+    if (diff < -(int64_t)US_PER_DAY / 2) diff += US_PER_DAY;
+    if (diff > RTC_RESAVE_DRIFT_US || diff < -RTC_RESAVE_DRIFT_US) {
+        saveMissionTime();
+    }
+}
+
+static void disciplineEpoch(uint32_t gpsMs, uint64_t arrivalUs) {
+    // GPS time at the moment the sentence arrived vs mission time at that moment,
+    // wrapped to +-12 h.
+    int64_t gpsUs = ((int64_t)gpsMs + paramU32(PRM_GPS_TIME_LATENCY_MS)) * 1000;
+    int64_t errUs = (gpsUs - (int64_t)missionUsAt(arrivalUs)) % (int64_t)US_PER_DAY;
+    if (errUs > (int64_t)US_PER_DAY / 2) errUs -= US_PER_DAY;
+    if (errUs < -(int64_t)US_PER_DAY / 2) errUs += US_PER_DAY;
+
+    bool gap = (arrivalUs - lastEpochUs) > DISC_GAP_RESTART_US;
+    float dt = (float)(arrivalUs - lastEpochUs) * 1e-6f;
+    lastEpochUs = arrivalUs;
+    if (!discRunning || gap) {
+        // (Re)start: steer to GPS if ST put us within a second of it, otherwise
+        // keep the operator's offset and only track frequency.
+        discTargetUs = (errUs > -DISC_STEER_LIMIT_US && errUs < DISC_STEER_LIMIT_US) ? 0 : errUs;
+        discRunning = true;
+        disc.epochs = 0;
+        return;
+    }
+
+    int64_t phaseUs = errUs - discTargetUs;
+    if (phaseUs > DISC_OUTLIER_US || phaseUs < -DISC_OUTLIER_US) {
+        disc.rejected++;
+        return;
+    }
+
+    // Phase error in us over seconds is a rate in ppm; x1000 for ppb.
+    discFreqPpb += DISC_KI * (float)phaseUs * 1000.0f * dt;
+    if (discFreqPpb > DISC_MAX_FREQ_PPB) discFreqPpb = DISC_MAX_FREQ_PPB;
+    if (discFreqPpb < -DISC_MAX_FREQ_PPB) discFreqPpb = -DISC_MAX_FREQ_PPB;
+    float slew = discFreqPpb + DISC_KP * (float)phaseUs * 1000.0f;
+    if (slew > DISC_MAX_SLEW_PPB) slew = DISC_MAX_SLEW_PPB;
+    if (slew < -DISC_MAX_SLEW_PPB) slew = -DISC_MAX_SLEW_PPB;
+    setSlewPpb((int32_t)slew);
+
+    disc.epochs++;
+    disc.phaseErrorUs = (int32_t)phaseUs;
+    disc.slewPpb = slewPpb;
+}
+
+void getClockDiscipline(ClockDisciplineStatus* out) {
+    if (out == nullptr) return;
+    *out = disc;
+    out->locked = discRunning && disc.epochs >= DISC_LOCK_EPOCHS;
+    // A fast crystal needs a negative correction.
+    out->driftPpm = -discFreqPpb / 1000.0f;
+}
+
+bool optClockDriftPpm(const SensorSnapshot& snap, float* out) {
+    (void)snap;
+    if (!discRunning || disc.epochs < DISC_LOCK_EPOCHS) return false;
+    *out = -discFreqPpb / 1000.0f;
+    return true;
 }
 
 void updateTiming() {
-    // Timing currently derives mission time from millis() + offset; no periodic
-    // maintenance step is required here.
+    // Keep the 64-bit time base extended (must run at least once per micros() wrap).
+    getMonotonicUs();
+
+    uint32_t gpsMs;
+    uint64_t arrivalUs;
+    uint32_t epoch = getGPSTimeEpoch(gpsMs, arrivalUs);
+    if (timeSet && epoch != 0 && epoch != lastGpsEpoch) {
+        disciplineEpoch(gpsMs, arrivalUs);
+    }
+    lastGpsEpoch = epoch;
+
+    checkRtcAnchor();
 }
@@ -0,0 +1,153 @@
+// Apogee detector Monte Carlo: 500 simulated flights per case with a 50 Hz baro
+// (and 1 Hz SIMP, as in simulation mode), reporting detection latency after true
+// apogee and triggers before it.
+//   pio test -e native -f test_apogee_detector
+#include <unity.h>
+#include <Arduino.h>
+#include "ApogeeDetector.h"
+#include "NativeWorld.h"
+#include "Params.h"
+#include <math.h>
+#include <stdio.h>
+#include <random>
+
+static const int FLIGHTS = 500;
+static const float DT = 0.02f;  // Physics step = 50 Hz baro period
+
+struct FlightResult {
+    bool detected;
+    bool early;       // Declared before true apogee
+    double latencyS;  // Detection time - true apogee
+};
+
+struct CaseResult {
+    int detected;
+    int early;
+    double meanLatencyS;
+    double maxLatencyS;
+};
+
+void setUp() {}
+void tearDown() {}
+
+// Pad 5 s, boost at 60 m/s² to 6.5 s, ballistic coast, then -6 m/s under parachute.
+// Altitude is sampled every periodMs. The velocity fed in is a 0.25 s low-pass of
+// the derivative between samples, like getVerticalVelocity(); stuckVel feeds 0.
+static FlightResult fly(unsigned seed, uint32_t periodMs, float noiseM, bool stuckVel, float spikeProb) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, noiseM);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    resetApogeeDetector();
+
+    float z = 0.0f, v = 0.0f, velFilt = 0.0f, prevAlt = 0.0f;
+    bool firstSample = true;
+    double apogeeS = -1.0;
+    for (int k = 1; k < 4000; k++) {
+        float t = k * DT;
+        uint32_t ms = (uint32_t)lround(t * 1000.0f);
+        if (t < 5.0f) {
+            z = 0.0f;
+            v = 0.0f;
+        } else if (t < 6.5f) {
+            v += 60.0f * DT;
+            z += v * DT;
+        } else {
+            if (v > -6.0f) v = fmaxf(v - 9.81f * DT, -6.0f);
+            z += v * DT;
+        }
+        if (apogeeS < 0.0 && t > 6.5f && v <= 0.0f) apogeeS = t;
+        if (ms % periodMs != 0) continue;
+
+        float alt = z + noise(rng);
+        if (uniform(rng) < spikeProb) alt += (uniform(rng) < 0.5f ? -15.0f : 15.0f) * noiseM;
+        float dt = periodMs / 1000.0f;
+        if (!firstSample) velFilt += dt / (0.25f + dt) * ((alt - prevAlt) / dt - velFilt);
+        firstSample = false;
+        prevAlt = alt;
+
+        if (t < 5.0f) {
+            apogeeObservePad(alt, ms);
+            continue;
+        }
+        if (t < 5.3f) continue;  // Liftoff not yet detected
+        if (apogeeDetectorUpdate(alt, stuckVel ? 0.0f : velFilt, ms)) {
+            bool early = apogeeS < 0.0 || t < apogeeS;
+            return { true, early, early ? 0.0 : t - apogeeS };
+        }
+        if (z < 0.0f) break;
+    }
+    return { false, false, 0.0 };
+}
+
+static CaseResult runCase(const char* name, uint32_t periodMs, float noiseM, bool stuckVel, float spikeProb) {
+    CaseResult r = {};
+    double total = 0.0;
+    for (int i = 0; i < FLIGHTS; i++) {
+        FlightResult f = fly((unsigned)i, periodMs, noiseM, stuckVel, spikeProb);
+        if (!f.detected) continue;
+        r.detected++;
+        if (f.early) {
+            r.early++;
+            continue;
+        }
+        total += f.latencyS;
+        r.maxLatencyS = fmax(r.maxLatencyS, f.latencyS);
+    }
+    int onTime = r.detected - r.early;
+    r.meanLatencyS = onTime > 0 ? total / onTime : 0.0;
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s: detected %d/%d, false %d, latency mean %.3f s max %.3f s",
+             name, r.detected, FLIGHTS, r.early, r.meanLatencyS, r.maxLatencyS);
+    TEST_MESSAGE(msg);
+    return r;
+}
+
+static void checkCase(const CaseResult& r, double maxLatencyS) {
+    TEST_ASSERT_EQUAL_INT(FLIGHTS, r.detected);
+    TEST_ASSERT_EQUAL_INT(0, r.early);
+    TEST_ASSERT_LESS_THAN(maxLatencyS, r.maxLatencyS);
+}
+
+static void test_clean_baro() {
+    checkCase(runCase("clean 0.1 m", 20, 0.1f, false, 0.0f), 1.0);
+}
+
+static void test_noisy_baro() {
+    checkCase(runCase("noisy 0.5 m", 20, 0.5f, false, 0.0f), 1.0);
+}
+
+static void test_very_noisy_baro() {
+    checkCase(runCase("noisy 1 m", 20, 1.0f, false, 0.0f), 1.5);
+}
+
+static void test_stuck_velocity() {
+    checkCase(runCase("stuck vel", 20, 0.3f, true, 0.0f), 1.0);
+}
+
+static void test_altitude_spikes() {
+    checkCase(runCase("spikes 2%", 20, 0.3f, false, 0.02f), 1.5);
+}
+
+static void test_simulation_mode_1hz() {
+    // SIMP delivers one sample per second. The velocity filter and the vote both
+    // count samples, so detection is seconds late (ApogeeDetector.h) but never early.
+    CaseResult r = runCase("SIMP 1 Hz", 1000, 0.1f, false, 0.0f);
+    checkCase(r, 12.0);
+    TEST_ASSERT_GREATER_THAN(4.0, r.meanLatencyS);
+}
+
+int main() {
+    Serial.nativeSetEnabled(false);
+    nativeSetFsRoot(".pio/test_fs/apogee_detector");
+    nativeClearFs();
+    initParams();  // Defaults
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_baro);
+    RUN_TEST(test_noisy_baro);
+    RUN_TEST(test_very_noisy_baro);
+    RUN_TEST(test_stuck_velocity);
+    RUN_TEST(test_altitude_spikes);
+    RUN_TEST(test_simulation_mode_1hz);
+    return UNITY_END();
+}
@@ -0,0 +1,170 @@
+// Binary telemetry frames: COBS framing, CRC and sample packing round trips.
+// BinaryFrame.cpp is also the GCS reference decoder, so both directions are checked.
+//   pio test -e native -f test_binary_frame
+#include <unity.h>
+#include "BinaryFrame.h"
+#include <string.h>
+#include <random>
+
+void setUp() {}
+void tearDown() {}
+
+static void randomSample(std::mt19937& rng, BinSample* s) {
+    uint8_t* p = (uint8_t*)s;
+    for (size_t i = 0; i < sizeof(*s); i++) p[i] = (uint8_t)rng();
+}
+
+static bool sameSample(const BinSample& a, const BinSample& b) {
+    return a.seq == b.seq && a.captureMs == b.captureMs && a.state == b.state &&
+           a.gpsSats == b.gpsSats && a.altitudeDm == b.altitudeDm &&
+           a.pressureDaPa == b.pressureDaPa && a.temperatureDc == b.temperatureDc &&
+           a.voltageMv == b.voltageMv && a.currentMa == b.currentMa &&
+           memcmp(a.gyroDds, b.gyroDds, sizeof(a.gyroDds)) == 0 &&
+           memcmp(a.accelCms2, b.accelCms2, sizeof(a.accelCms2)) == 0 &&
+           a.gpsLatE7 == b.gpsLatE7 && a.gpsLonE7 == b.gpsLonE7 &&
+           a.gpsAltDm == b.gpsAltDm && a.vertVelCms == b.vertVelCms;
+}
+
+// Wire frame must start and end with 0x00 and contain no other zero byte.
+static bool wellDelimited(const uint8_t* wire, size_t len) {
+    if (len < 2 || wire[0] != 0 || wire[len - 1] != 0) return false;
+    for (size_t i = 1; i + 1 < len; i++) {
+        if (wire[i] == 0) return false;
+    }
+    return true;
+}
+
+static void test_sample_frame_round_trip() {
+    std::mt19937 rng(3);
+    for (int it = 0; it < 200000; it++) {
+        BinSample s;
+        randomSample(rng, &s);
+        if (it % 3 == 0) memset(&s, 0, sizeof(s));  // All-zero body: worst case for COBS
+
+        uint8_t body[BIN_SAMPLE_BODY_SIZE];
+        TEST_ASSERT_EQUAL_size_t(BIN_SAMPLE_BODY_SIZE, binPackSample(s, body));
+        uint8_t wire[BIN_MAX_WIRE];
+        size_t wireLen = binEncodeFrame(BIN_FRAME_SAMPLE, body, sizeof(body), wire, sizeof(wire));
+        TEST_ASSERT_TRUE(wellDelimited(wire, wireLen));
+
+        uint8_t type = 0;
+        uint8_t out[BIN_MAX_BODY];
+        size_t outLen = binDecodeFrame(wire + 1, wireLen - 2, &type, out, sizeof(out));
+        TEST_ASSERT_EQUAL_size_t(sizeof(body), outLen);
+        TEST_ASSERT_EQUAL_UINT8(BIN_FRAME_SAMPLE, type);
+        TEST_ASSERT_EQUAL_MEMORY(body, out, sizeof(body));
+
+        BinSample back;
+        TEST_ASSERT_TRUE(binUnpackSample(out, outLen, &back));
+        TEST_ASSERT_TRUE(sameSample(s, back));
+    }
+}
+
+static void test_corrupted_byte_is_rejected() {
+    // CRC-16 catches every single-byte error in the raw frame; a hit on a COBS code
+    // byte instead breaks the framing, which the decoder also rejects.
+    std::mt19937 rng(4);
+    int accepted = 0;
+    for (int it = 0; it < 100000; it++) {
+        BinSample s;
+        randomSample(rng, &s);
+        uint8_t body[BIN_SAMPLE_BODY_SIZE];
+        binPackSample(s, body);
+        uint8_t wire[BIN_MAX_WIRE];
+        size_t wireLen = binEncodeFrame(BIN_FRAME_SAMPLE, body, sizeof(body), wire, sizeof(wire));
+        wire[1 + rng() % (wireLen - 2)] ^= (uint8_t)(1 + rng() % 255);
+
+        uint8_t type;
+        uint8_t out[BIN_MAX_BODY];
+        if (binDecodeFrame(wire + 1, wireLen - 2, &type, out, sizeof(out)) != 0) accepted++;
+    }
+    TEST_ASSERT_EQUAL_INT(0, accepted);
+}
+
+static void test_largest_body_round_trip() {
+    // 240-byte bodies need a COBS block longer than 254 bytes split in two.
+    uint8_t body[BIN_MAX_BODY];
+    uint8_t wire[BIN_MAX_WIRE];
+    uint8_t out[BIN_MAX_BODY];
+    uint8_t type;
+    for (int pattern = 0; pattern < 2; pattern++) {
+        for (size_t i = 0; i < sizeof(body); i++) {
+            body[i] = pattern == 0 ? (uint8_t)(i % 7 ? i : 0) : (uint8_t)(i + 1);
+        }
+        size_t wireLen = binEncodeFrame(BIN_FRAME_LOG, body, sizeof(body), wire, sizeof(wire));
+        TEST_ASSERT_TRUE(wellDelimited(wire, wireLen));
+        TEST_ASSERT_LESS_OR_EQUAL(BIN_MAX_WIRE, wireLen);
+        TEST_ASSERT_EQUAL_size_t(sizeof(body), binDecodeFrame(wire + 1, wireLen - 2, &type, out, sizeof(out)));
+        TEST_ASSERT_EQUAL_MEMORY(body, out, sizeof(body));
+    }
+    TEST_ASSERT_EQUAL_size_t(0, binEncodeFrame(BIN_FRAME_LOG, body, BIN_MAX_BODY + 1, wire, sizeof(wire)));
+}
+
+static void test_state_event_round_trip() {
+    BinStateEvent e = { 7, 4, 5, 123456789u, 0xFFFFFFFFu };
+    uint8_t body[BIN_STATE_BODY_SIZE];
+    TEST_ASSERT_EQUAL_size_t(BIN_STATE_BODY_SIZE, binPackStateEvent(e, body));
+    BinStateEvent back;
+    TEST_ASSERT_TRUE(binUnpackStateEvent(body, sizeof(body), &back));
+    TEST_ASSERT_EQUAL_UINT8(7, back.burstId);
+    TEST_ASSERT_EQUAL_UINT8(4, back.fromState);
+    TEST_ASSERT_EQUAL_UINT8(5, back.toState);
+    TEST_ASSERT_EQUAL_UINT32(123456789u, back.transitionMs);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, back.missionMs);
+    TEST_ASSERT_FALSE(binUnpackStateEvent(body, sizeof(body) - 1, &back));
+}
+
+static void test_delta_round_trip_and_size_bound() {
+    std::mt19937 rng(5);
+    BinSample prev, cur, back;
+    uint8_t body[BIN_DELTA_MAX_BODY];
+    for (int it = 0; it < 200000; it++) {
+        randomSample(rng, &prev);
+        randomSample(rng, &cur);  // Random pairs: deltas up to the full 32-bit range
+        size_t len = binPackDelta(prev, cur, body, sizeof(body));
+        TEST_ASSERT_GREATER_THAN(2u, len);
+        TEST_ASSERT_LESS_OR_EQUAL(BIN_DELTA_MAX_BODY, len);
+        TEST_ASSERT_TRUE(binUnpackDelta(prev, body, len, &back));
+        TEST_ASSERT_TRUE(sameSample(cur, back));
+        TEST_ASSERT_FALSE(binUnpackDelta(prev, body, len - 1, &back));  // Last varint cut
+    }
+    // Unchanged sample: seq plus one byte per field.
+    TEST_ASSERT_EQUAL_size_t(2 + BIN_DELTA_FIELD_COUNT, binPackDelta(cur, cur, body, sizeof(body)));
+    TEST_ASSERT_EQUAL_size_t(0, binPackDelta(prev, cur, body, BIN_DELTA_MAX_BODY - 1));
+}
+
+static void test_decoder_drops_deltas_after_a_gap() {
+    BinSample s[4];
+    memset(s, 0, sizeof(s));
+    for (int i = 0; i < 4; i++) {
+        s[i].seq = (uint16_t)(100 + i);
+        s[i].altitudeDm = 1000 + 7 * i;
+    }
+    uint8_t key[BIN_SAMPLE_BODY_SIZE];
+    uint8_t d1[BIN_DELTA_MAX_BODY], d3[BIN_DELTA_MAX_BODY];
+    binPackSample(s[0], key);
+    size_t d1Len = binPackDelta(s[0], s[1], d1, sizeof(d1));
+    size_t d3Len = binPackDelta(s[2], s[3], d3, sizeof(d3));
+
+    BinStreamDecoder dec;
+    binDecoderReset(&dec);
+    BinSample out;
+    TEST_ASSERT_FALSE(binDecoderFeed(&dec, BIN_FRAME_DELTA, d1, d1Len, &out));  // No keyframe yet
+    TEST_ASSERT_TRUE(binDecoderFeed(&dec, BIN_FRAME_SAMPLE, key, sizeof(key), &out));
+    TEST_ASSERT_TRUE(binDecoderFeed(&dec, BIN_FRAME_DELTA, d1, d1Len, &out));
+    TEST_ASSERT_TRUE(sameSample(s[1], out));
+    // Frame 102 lost: the delta for 103 must not apply on top of 101.
+    TEST_ASSERT_FALSE(binDecoderFeed(&dec, BIN_FRAME_DELTA, d3, d3Len, &out));
+    TEST_ASSERT_FALSE(dec.valid);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_sample_frame_round_trip);
+    RUN_TEST(test_corrupted_byte_is_rejected);
+    RUN_TEST(test_largest_body_round_trip);
+    RUN_TEST(test_state_event_round_trip);
+    RUN_TEST(test_delta_round_trip_and_size_bound);
+    RUN_TEST(test_decoder_drops_deltas_after_a_gap);
+    return UNITY_END();
+}
@@ -0,0 +1,131 @@
+// Binary side-stream benchmark: wire bytes per sample and encode cost for full
+// and delta frames on a synthetic 10 Hz flight, decoded through a lossy link.
+//   pio test -e native -f test_binary_stream
+#include <unity.h>
+#include "BinaryFrame.h"
+#include "BinaryTelemetry.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+
+static const int FRAMES = 3000;  // 5 minutes at 10 Hz
+
+struct StreamResult {
+    double bytesPerFrame;
+    double encodeNs;   // Pack + COBS/CRC per frame on the host
+    long decoded;
+    long wrong;
+};
+
+void setUp() {}
+void tearDown() {}
+
+// Ascent at 30 m/s for 12 s, then 5 m/s descent; sensor noise on every channel.
+static void syntheticSample(int i, std::mt19937& rng, BinSample* s) {
+    std::normal_distribution<float> n(0.0f, 1.0f);
+    float t = i * 0.1f;
+    float alt = t < 12.0f ? 30.0f * t : 360.0f - 5.0f * (t - 12.0f);
+    memset(s, 0, sizeof(*s));
+    s->seq = (uint16_t)i;
+    s->captureMs = 1000 + 100 * i + rng() % 3;
+    s->state = 2;
+    s->gpsSats = 9;
+    s->altitudeDm = lroundf((alt + 0.2f * n(rng)) * 10.0f);
+    s->pressureDaPa = (uint16_t)(10132 - s->altitudeDm / 8);
+    s->temperatureDc = 215;
+    s->voltageMv = (uint16_t)(8100 + rng() % 5);
+    s->currentMa = (int16_t)(450 + rng() % 20);
+    for (int k = 0; k < 3; k++) {
+        s->gyroDds[k] = (int16_t)lroundf(50.0f * n(rng));
+        s->accelCms2[k] = (int16_t)lroundf(30.0f * n(rng));
+    }
+    s->gpsLatE7 = 383759610 + i * 3;
+    s->gpsLonE7 = -796078720 - i * 2;
+    s->gpsAltDm = s->altitudeDm + 6000;
+    s->vertVelCms = (int16_t)lroundf(100.0f * n(rng));
+}
+
+// Encode like updateBinaryTelemetry (keyframe every BIN_KEYFRAME_INTERVAL in delta
+// mode), lose lossPercent of the frames, decode the rest with BinStreamDecoder.
+static StreamResult runStream(bool delta, unsigned lossPercent) {
+    std::mt19937 rng(5);
+    BinStreamDecoder dec;
+    binDecoderReset(&dec);
+    BinSample prev;
+    long bytes = 0;
+    double encodeNs = 0.0;
+    StreamResult r = {};
+    for (int i = 0; i < FRAMES; i++) {
+        BinSample s;
+        syntheticSample(i, rng, &s);
+        bool key = !delta || i % BIN_KEYFRAME_INTERVAL == 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+        uint8_t body[BIN_DELTA_MAX_BODY];
+        size_t bodyLen = key ? binPackSample(s, body) : binPackDelta(prev, s, body, sizeof(body));
+        uint8_t wire[BIN_MAX_WIRE];
+        size_t wireLen = binEncodeFrame(key ? BIN_FRAME_SAMPLE : BIN_FRAME_DELTA, body, bodyLen,
+                                        wire, sizeof(wire));
+        encodeNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        bytes += (long)wireLen;
+        prev = s;
+
+        if (rng() % 100 < lossPercent) continue;
+        uint8_t type;
+        uint8_t out[BIN_MAX_BODY];
+        size_t outLen = binDecodeFrame(wire + 1, wireLen - 2, &type, out, sizeof(out));
+        BinSample got;
+        if (binDecoderFeed(&dec, type, out, outLen, &got)) {
+            r.decoded++;
+            uint8_t a[BIN_SAMPLE_BODY_SIZE], b[BIN_SAMPLE_BODY_SIZE];
+            binPackSample(got, a);
+            binPackSample(s, b);
+            if (memcmp(a, b, sizeof(a)) != 0) r.wrong++;
+        }
+    }
+    r.bytesPerFrame = (double)bytes / FRAMES;
+    r.encodeNs = encodeNs / FRAMES;
+    return r;
+}
+
+static void report(const char* name, const StreamResult& r) {
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s: %.1f bytes/sample, %.0f ns encode, %ld/%d decoded, %ld wrong",
+             name, r.bytesPerFrame, r.encodeNs, r.decoded, FRAMES, r.wrong);
+    TEST_MESSAGE(msg);
+}
+
+static void test_full_frames_are_fixed_size() {
+    StreamResult r = runStream(false, 0);
+    report("full", r);
+    // 46-byte body + type, version, CRC, COBS overhead and two delimiters.
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 53.0f, (float)r.bytesPerFrame);
+    TEST_ASSERT_EQUAL_INT(FRAMES, r.decoded);
+    TEST_ASSERT_EQUAL_INT(0, r.wrong);
+}
+
+static void test_delta_frames_save_a_third() {
+    StreamResult full = runStream(false, 0);
+    StreamResult delta = runStream(true, 0);
+    report("delta", delta);
+    TEST_ASSERT_LESS_THAN(full.bytesPerFrame * 2.0 / 3.0, delta.bytesPerFrame);
+    TEST_ASSERT_EQUAL_INT(FRAMES, delta.decoded);
+    TEST_ASSERT_EQUAL_INT(0, delta.wrong);
+}
+
+static void test_delta_loss_costs_samples_not_values() {
+    StreamResult r = runStream(true, 10);
+    report("delta, 10% loss", r);
+    TEST_ASSERT_EQUAL_INT(0, r.wrong);
+    TEST_ASSERT_GREATER_THAN(FRAMES / 2, r.decoded);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_frames_are_fixed_size);
+    RUN_TEST(test_delta_frames_save_a_third);
+    RUN_TEST(test_delta_loss_costs_samples_not_values);
+    return UNITY_END();
+}
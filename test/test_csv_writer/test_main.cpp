@@ -0,0 +1,106 @@
+// CsvWriter golden test: csvPutFixed must be byte-identical to printf("%.*f"),
+// which the GCS parser and the pre-CsvWriter telemetry format rely on.
+//   pio test -e native -f test_csv_writer
+#include <unity.h>
+#include "CsvWriter.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <random>
+
+static long checked = 0;
+static int mismatches = 0;
+
+void setUp() {}
+void tearDown() {}
+
+static void checkFixed(float v, uint8_t decimals) {
+    char expect[64], got[64];
+    snprintf(expect, sizeof(expect), "%.*f", decimals, v);
+    CsvWriter w;
+    csvBegin(&w, got, sizeof(got));
+    csvPutFixed(&w, v, decimals);
+    got[w.len] = '\0';
+    checked++;
+    if (strcmp(expect, got) != 0 && mismatches++ < 10) {
+        printf("%.9g decimals %u: printf \"%s\", csvPutFixed \"%s\"\n", v, decimals, expect, got);
+    }
+}
+
+static void test_fixed_matches_printf_random_bits() {
+    std::mt19937 rng(1);
+    for (int i = 0; i < 2000000; i++) {
+        uint32_t bits = rng();
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        if (isnan(v) || fabsf(v) > 1e12f) continue;
+        checkFixed(v, 1 + i % 4);
+    }
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+}
+
+static void test_fixed_matches_printf_telemetry_range() {
+    // Altitude, pressure, voltages, rates: every resolution the telemetry uses and more.
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> u(-2000.0f, 2000.0f);
+    for (int i = 0; i < 500000; i++) {
+        float v = u(rng);
+        for (uint8_t d = 0; d <= 6; d++) checkFixed(v, d);
+    }
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+}
+
+static void test_fixed_matches_printf_rounding_ties() {
+    // Values on and next to the rounding boundary of each resolution.
+    for (int k = -100000; k <= 100000; k++) {
+        for (uint8_t d = 1; d <= 4; d++) {
+            checkFixed(k * 0.05f, d);
+            checkFixed(k / 2.0f / powf(10.0f, d), d);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+}
+
+static void test_fixed_special_values() {
+    checkFixed(-0.0f, 1);
+    checkFixed(-0.04f, 1);
+    checkFixed(INFINITY, 1);
+    checkFixed(-INFINITY, 2);
+    checkFixed(NAN, 1);
+    TEST_ASSERT_EQUAL_INT(0, mismatches);
+}
+
+static void test_line_layout() {
+    char buf[64];
+    CsvWriter w;
+    csvBegin(&w, buf, sizeof(buf));
+    csvPutUInt(&w, 57, 4);
+    csvPutTime(&w, 1, 2, 3);
+    csvPutEmpty(&w);
+    csvPutUInt(&w, 4294967295u);
+    csvPutFixed(&w, -1.25f, 1);
+    TEST_ASSERT_EQUAL_UINT32(32, csvEnd(&w));
+    TEST_ASSERT_EQUAL_STRING("0057,01:02:03,,4294967295,-1.2\r\n", buf);
+}
+
+static void test_overflow_reports_zero() {
+    char buf[8];
+    CsvWriter w;
+    csvBegin(&w, buf, sizeof(buf));
+    csvPutStr(&w, "TOO,LONG");
+    TEST_ASSERT_EQUAL_UINT32(0, csvEnd(&w));
+    TEST_ASSERT_TRUE(w.overflow);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_fixed_matches_printf_random_bits);
+    RUN_TEST(test_fixed_matches_printf_telemetry_range);
+    RUN_TEST(test_fixed_matches_printf_rounding_ties);
+    RUN_TEST(test_fixed_special_values);
+    RUN_TEST(test_line_layout);
+    RUN_TEST(test_overflow_reports_zero);
+    int failures = UNITY_END();
+    printf("%ld values checked\n", checked);
+    return failures;
+}
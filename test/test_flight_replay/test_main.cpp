@@ -0,0 +1,70 @@
+// Replays lib/ArduinoNative/examples/sample_flight.* through the unmodified
+// setup()/loop() on the virtual clock and checks the flight and GPS outcome.
+//   pio test -e native -f test_flight_replay
+#include <unity.h>
+#include <Arduino.h>
+#include "NativeReplay.h"
+#include "NativeWorld.h"
+#include "FlightState.h"
+#include "Sensors.h"
+
+static const uint32_t TICK_US = 1000;
+
+static bool visited[LANDED + 1];
+static double landedAtS = -1.0;
+
+void setUp() {}
+void tearDown() {}
+
+static void test_sample_flight_replays() {
+    nativeSetFsRoot(".pio/test_fs/flight_replay");
+    nativeClearFs();  // Blank board: no restored state or parameters from an earlier run
+    Serial.nativeSetEnabled(false);
+    TEST_ASSERT_TRUE(nativeLoadProfile("lib/ArduinoNative/examples/sample_flight.profile"));
+    TEST_ASSERT_TRUE(nativeLoadCommands("lib/ArduinoNative/examples/sample_flight.cmds"));
+    TEST_ASSERT_TRUE(nativeLoadGps("lib/ArduinoNative/examples/sample_flight.gps"));
+
+    nativeReplayStep(0.0);
+    setup();
+    const uint64_t endUs = 150000000ULL;
+    while (nativeMicros64() < endUs) {
+        double t = nativeMicros64() / 1e6;
+        nativeReplayStep(t);
+        nativeLoopPass(TICK_US);
+        visited[flightState] = true;
+        if (flightState == LANDED && landedAtS < 0.0) landedAtS = t;
+    }
+}
+
+static void test_sample_flight_walks_every_state() {
+    for (int s = LAUNCH_PAD; s <= LANDED; s++) {
+        char msg[48];
+        snprintf(msg, sizeof(msg), "never entered %s", flightStateToString((FlightState)s));
+        TEST_ASSERT_TRUE_MESSAGE(visited[s], msg);
+    }
+}
+
+static void test_sample_flight_lands_after_touchdown() {
+    // Touchdown at 101.6 s; the landing detector needs its window plus the confirm time.
+    TEST_ASSERT_EQUAL_STRING("LANDED", flightStateToString(flightState));
+    TEST_ASSERT_GREATER_THAN(101.6, landedAtS);
+    TEST_ASSERT_LESS_THAN(110.0, landedAtS);
+}
+
+static void test_sample_gps_gives_fix() {
+    uint8_t h, m, s;
+    TEST_ASSERT_TRUE(getGPSTime(h, m, s));
+    TEST_ASSERT_EQUAL_UINT8(8, getGPSSatellites());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, getGPSAltitude());  // Pad MSL, after touchdown
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 37.75f, getGPSLatitude());
+    TEST_ASSERT_GREATER_THAN(0u, (unsigned)strlen(getLastNMEASentence()));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_sample_flight_replays);  // Flies once; the checks below read the outcome
+    RUN_TEST(test_sample_flight_walks_every_state);
+    RUN_TEST(test_sample_flight_lands_after_touchdown);
+    RUN_TEST(test_sample_gps_gives_fix);
+    return UNITY_END();
+}
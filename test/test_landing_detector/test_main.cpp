@@ -0,0 +1,120 @@
+// Landing detector on synthetic 100 Hz descents: a separation shock high up must
+// not count as the touchdown impact of a later soft landing.
+//   pio test -e native -f test_landing_detector
+#include <unity.h>
+#include <Arduino.h>
+#include "EventJournal.h"
+#include "LandingDetector.h"
+#include "NativeWorld.h"
+#include "Params.h"
+#include <math.h>
+#include <random>
+
+static const uint32_t TICK_MS = 10;
+static const uint32_t TOUCHDOWN_MS = 60000;
+static const uint32_t END_MS = 80000;
+
+struct Spike {
+    uint32_t ms;
+    float accel;
+};
+
+struct Run {
+    bool landed;
+    LandingDetectorStatus status;
+    int impactEvents;
+    JournalEntry impact;
+    JournalEntry landing;
+};
+
+void setUp() {}
+void tearDown() {}
+
+// Descent at 5 m/s from 300 m with a swinging payload, then still on the ground
+// from TOUCHDOWN_MS. Spikes replace the acceleration sample at their tick.
+static Run fly(const Spike* spikes, int spikeCount) {
+    std::mt19937 rng(7);
+    std::normal_distribution<float> n(0.0f, 1.0f);
+    resetLandingDetector();
+    uint32_t firstRecord = journalHead();
+
+    for (uint32_t ms = TICK_MS; ms <= END_MS && !isLandingConfirmed(); ms += TICK_MS) {
+        float alt, accel, vz;
+        if (ms < TOUCHDOWN_MS) {
+            alt = 300.0f - 5.0f * ms / 1000.0f + 0.1f * n(rng);
+            accel = fabsf(1.5f + n(rng));
+            vz = -5.0f + 0.3f * n(rng);
+        } else {
+            alt = 0.03f * n(rng);
+            accel = fabsf(0.05f * n(rng));
+            vz = 0.02f * n(rng);
+        }
+        for (int i = 0; i < spikeCount; i++) {
+            if (spikes[i].ms == ms) accel = spikes[i].accel;
+        }
+        updateLandingDetector(alt, accel, vz, ms);
+    }
+
+    Run r = {};
+    r.landed = isLandingConfirmed();
+    getLandingDetectorStatus(&r.status);
+    for (uint32_t i = firstRecord; i < journalHead(); i++) {
+        JournalEntry e;
+        if (!journalRead(i, &e)) continue;
+        if (e.id == EVT_IMPACT) {
+            r.impactEvents++;
+            r.impact = e;
+        }
+        if (e.id == EVT_LANDING) r.landing = e;
+    }
+    return r;
+}
+
+static void test_separation_shock_then_soft_landing() {
+    const Spike spikes[] = { { 200, 45.0f }, { 260, 30.0f } };
+    Run r = fly(spikes, 2);
+    TEST_ASSERT_TRUE(r.landed);
+    TEST_ASSERT_TRUE(r.status.impactSeen);
+    TEST_ASSERT_FALSE(r.status.impact);
+    // No touchdown impact: twice LAND_CONFIRM_MS of stillness.
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2 * paramU32(PRM_LAND_CONFIRM_MS),
+                                        r.status.landedMs - r.status.stillSinceMs);
+    TEST_ASSERT_EQUAL_INT(0, r.impactEvents);
+    TEST_ASSERT_EQUAL_UINT8(0, r.landing.a);
+}
+
+static void test_touchdown_impact_confirms_sooner() {
+    const Spike spikes[] = { { 200, 45.0f }, { TOUCHDOWN_MS, 35.0f }, { TOUCHDOWN_MS + 150, 25.0f } };
+    Run r = fly(spikes, 3);
+    TEST_ASSERT_TRUE(r.landed);
+    TEST_ASSERT_TRUE(r.status.impact);
+    TEST_ASSERT_EQUAL_UINT32(paramU32(PRM_LAND_CONFIRM_MS), r.status.landedMs - r.status.stillSinceMs);
+    TEST_ASSERT_LESS_THAN_UINT32(TOUCHDOWN_MS + 4000, r.status.landedMs);
+    // The touchdown (bounce included) is journaled once with its peak, not the separation.
+    TEST_ASSERT_EQUAL_INT(1, r.impactEvents);
+    TEST_ASSERT_EQUAL_UINT32(3500, r.impact.b);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT8(paramU32(PRM_LAND_IMPACT_WINDOW_MS) / 100, r.impact.a);
+    TEST_ASSERT_EQUAL_UINT8(1, r.landing.a);
+}
+
+static void test_impact_long_before_stillness_does_not_count() {
+    // A shock in the last seconds of descent (a branch, a gust) is not the touchdown.
+    const Spike spikes[] = { { TOUCHDOWN_MS - 5000, 40.0f } };
+    Run r = fly(spikes, 1);
+    TEST_ASSERT_TRUE(r.landed);
+    TEST_ASSERT_FALSE(r.status.impact);
+    TEST_ASSERT_EQUAL_INT(0, r.impactEvents);
+}
+
+int main() {
+    Serial.nativeSetEnabled(false);
+    nativeSetFsRoot(".pio/test_fs/landing_detector");
+    nativeClearFs();
+    initParams();  // Defaults
+    initEventJournal();
+    UNITY_BEGIN();
+    RUN_TEST(test_separation_shock_then_soft_landing);
+    RUN_TEST(test_touchdown_impact_confirms_sooner);
+    RUN_TEST(test_impact_long_before_stillness_does_not_count);
+    return UNITY_END();
+}
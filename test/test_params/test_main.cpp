@@ -0,0 +1,145 @@
+// Parameter persistence: the EEPROM block is keyed per entry, so a build with a
+// different table still loads every stored value it recognises.
+//   pio test -e native -f test_params
+#include <unity.h>
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "NativeWorld.h"
+#include "FlightState.h"
+#include "Params.h"
+
+// Block layout (Params.cpp): magic, count, CRC, then 8-byte (hash, value) entries.
+static const int COUNT_ADDR = 104;
+static const int CRC_ADDR = 106;
+static const int ENTRIES_ADDR = 108;
+
+void setUp() {
+    Serial.nativeSetEnabled(false);
+    flightState = PRELAUNCH;
+    for (int a = 100; a < 700; a++) EEPROM.write(a, 0xFF);  // Never saved
+}
+
+void tearDown() {}
+
+static uint32_t readU32(int addr) {
+    return (uint32_t)EEPROM.read(addr) | ((uint32_t)EEPROM.read(addr + 1) << 8) |
+           ((uint32_t)EEPROM.read(addr + 2) << 16) | ((uint32_t)EEPROM.read(addr + 3) << 24);
+}
+
+static void writeU16(int addr, uint16_t v) {
+    EEPROM.write(addr, (uint8_t)v);
+    EEPROM.write(addr + 1, (uint8_t)(v >> 8));
+}
+
+static uint16_t blockCrc(uint16_t count) {
+    uint16_t crc = 0xFFFF;
+    for (int a = COUNT_ADDR; a < COUNT_ADDR + 2; a++) {
+        crc ^= (uint16_t)EEPROM.read(a) << 8;
+        for (int k = 0; k < 8; k++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    for (int a = ENTRIES_ADDR; a < ENTRIES_ADDR + 8 * count; a++) {
+        crc ^= (uint16_t)EEPROM.read(a) << 8;
+        for (int k = 0; k < 8; k++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+// Rewrite the stored block as an older build would have: only the first count entries.
+static void truncateStoredTable(uint16_t count) {
+    writeU16(COUNT_ADDR, count);
+    writeU16(CRC_ADDR, blockCrc(count));
+}
+
+static void test_defaults_when_never_saved() {
+    initParams();
+    for (size_t i = 0; i < PARAM_COUNT; i++) {
+        TEST_ASSERT_EQUAL_MESSAGE(1, param((ParamId)i) == paramInfo((ParamId)i)->defaultValue,
+                                  paramInfo((ParamId)i)->name);
+    }
+}
+
+static void test_values_survive_reboot() {
+    initParams();
+    TEST_ASSERT_TRUE(paramSet(PRM_VZ_KP, 0.9f));
+    TEST_ASSERT_TRUE(paramSet(PRM_LAND_CONFIRM_MS, 2500));
+    paramValues[PRM_VZ_KP] = 0.0f;  // Lose RAM
+    initParams();
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.9f, param(PRM_VZ_KP));
+    TEST_ASSERT_EQUAL_UINT32(2500, paramU32(PRM_LAND_CONFIRM_MS));
+}
+
+static void test_appended_parameters_keep_the_rest() {
+    // Stored by a build whose table ended before the LandingDetector entries.
+    initParams();
+    TEST_ASSERT_TRUE(paramSet(PRM_VZ_KP, 0.9f));
+    TEST_ASSERT_TRUE(paramSet(PRM_LAND_CONFIRM_MS, 2500));
+    truncateStoredTable(PRM_LAND_WINDOW_SAMPLES);
+    initParams();
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.9f, param(PRM_VZ_KP));
+    TEST_ASSERT_EQUAL_UINT32(2000, paramU32(PRM_LAND_CONFIRM_MS));  // New here: default
+}
+
+static void test_reordered_entries_match_by_name() {
+    initParams();
+    TEST_ASSERT_TRUE(paramSet(PRM_VZ_KP, 0.9f));
+    TEST_ASSERT_TRUE(paramSet(PRM_VZ_KI, 0.3f));
+    // Swap the two stored entries (another build declared them the other way round).
+    int a = ENTRIES_ADDR + 8 * PRM_VZ_KP;
+    int b = ENTRIES_ADDR + 8 * PRM_VZ_KI;
+    for (int k = 0; k < 8; k++) {
+        uint8_t t = EEPROM.read(a + k);
+        EEPROM.write(a + k, EEPROM.read(b + k));
+        EEPROM.write(b + k, t);
+    }
+    truncateStoredTable(PARAM_COUNT);
+    initParams();
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.9f, param(PRM_VZ_KP));
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.3f, param(PRM_VZ_KI));
+}
+
+static void test_corrupt_block_gives_defaults() {
+    initParams();
+    TEST_ASSERT_TRUE(paramSet(PRM_VZ_KP, 0.9f));
+    int addr = ENTRIES_ADDR + 8 * PRM_VZ_KP + 4;
+    EEPROM.write(addr, EEPROM.read(addr) ^ 0x01);
+    initParams();
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, paramInfo(PRM_VZ_KP)->defaultValue, param(PRM_VZ_KP));
+    TEST_ASSERT_EQUAL_UINT32(0x324D5250UL, readU32(100));
+}
+
+static void test_flight_changes_saved_after_landing() {
+    initParams();
+    TEST_ASSERT_TRUE(paramSet(PRM_VZ_KP, 0.9f));
+    uint8_t before[600];
+    for (int a = 0; a < 600; a++) before[a] = EEPROM.read(100 + a);
+
+    flightState = DESCENT;
+    TEST_ASSERT_TRUE(paramSet(PRM_VZ_KP, 1.1f));
+    paramResetAll();
+    TEST_ASSERT_TRUE(paramSet(PRM_LAND_CONFIRM_MS, 2500));
+    updateParams();
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.85f, param(PRM_VZ_KP));  // Applied in RAM at once
+    TEST_ASSERT_TRUE(paramsSavePending());
+    for (int a = 0; a < 600; a++) TEST_ASSERT_EQUAL_UINT8(before[a], EEPROM.read(100 + a));
+
+    flightState = LANDED;
+    updateParams();
+    TEST_ASSERT_FALSE(paramsSavePending());
+    paramValues[PRM_LAND_CONFIRM_MS] = 0.0f;  // Lose RAM
+    initParams();
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.85f, param(PRM_VZ_KP));
+    TEST_ASSERT_EQUAL_UINT32(2500, paramU32(PRM_LAND_CONFIRM_MS));
+}
+
+int main() {
+    nativeSetFsRoot(".pio/test_fs/params");
+    nativeClearFs();
+    UNITY_BEGIN();
+    RUN_TEST(test_defaults_when_never_saved);
+    RUN_TEST(test_values_survive_reboot);
+    RUN_TEST(test_appended_parameters_keep_the_rest);
+    RUN_TEST(test_reordered_entries_match_by_name);
+    RUN_TEST(test_corrupt_block_gives_defaults);
+    RUN_TEST(test_flight_changes_saved_after_landing);
+    return UNITY_END();
+}
@@ -0,0 +1,57 @@
+// AGG window bookkeeping: windows close only on packets, so nothing may pile up
+// while telemetry is off.
+//   pio test -e native -f test_telemetry_aggregate
+#include <unity.h>
+#include <Arduino.h>
+#include "TelemetryAggregate.h"
+#include "telemetry.h"
+#include "Sensors.h"
+
+void setUp() {
+    Serial.nativeSetEnabled(false);
+    setTelemetryEnabled(false);
+    initTelemetryAggregate();
+    setTelemetryAggregateEnabled(true);
+}
+
+void tearDown() {}
+
+static uint32_t closedWindowSamples() {
+    SensorSnapshot snap;
+    captureSensorSnapshot(&snap);
+    closeTelemetryAggregateWindow(&snap);
+    uint32_t n = 0;
+    optAggSamples(snap, &n);
+    return n;
+}
+
+static void test_no_accumulation_while_telemetry_off() {
+    for (int i = 0; i < 6000; i++) updateTelemetryAggregate();  // A minute at 100 Hz
+    TEST_ASSERT_EQUAL_UINT32(0, closedWindowSamples());
+}
+
+static void test_first_window_starts_at_cx_on() {
+    setTelemetryEnabled(true);
+    for (int i = 0; i < 100; i++) updateTelemetryAggregate();
+    setTelemetryEnabled(false);
+    for (int i = 0; i < 500; i++) updateTelemetryAggregate();
+    setTelemetryEnabled(true);  // The partial window from before CX,OFF is dropped
+    for (int i = 0; i < 3; i++) updateTelemetryAggregate();
+    TEST_ASSERT_EQUAL_UINT32(3, closedWindowSamples());
+}
+
+static void test_windows_close_per_packet() {
+    setTelemetryEnabled(true);
+    for (int i = 0; i < 100; i++) updateTelemetryAggregate();
+    TEST_ASSERT_EQUAL_UINT32(100, closedWindowSamples());
+    for (int i = 0; i < 98; i++) updateTelemetryAggregate();
+    TEST_ASSERT_EQUAL_UINT32(98, closedWindowSamples());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_accumulation_while_telemetry_off);
+    RUN_TEST(test_first_window_starts_at_cx_on);
+    RUN_TEST(test_windows_close_per_packet);
+    return UNITY_END();
+}